@@ -0,0 +1,186 @@
+//============================================================================
+// Name        : Bid.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bid model shared by the bid container programs
+//============================================================================
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Bid.hpp"
+
+using namespace std;
+
+/**
+ * Display the bid information to the console (std::out)
+ *
+ * @param bid struct containing the bid info
+ */
+void displayBid(const Bid& bid) {
+    // no flush per bid; cout is flushed before the next read from cin
+    cout << bid.bidId << ": " << bid.title << " | " << bid.amount << " | "
+            << bid.fund << '\n';
+    return;
+}
+
+/**
+ * Append the line displayBid prints for a bid to a string, without
+ * going through a stream
+ *
+ * @param out String to append to
+ * @param bid The bid to format
+ */
+void formatBid(string& out, const Bid& bid) {
+    // the amount as a stream prints a double by default: 6 significant digits
+    char amount[32];
+    char* end = to_chars(amount, amount + sizeof(amount), bid.amount,
+            chars_format::general, 6).ptr;
+
+    out.append(bid.bidId).append(": ").append(bid.title).append(" | ");
+    out.append(amount, end).append(" | ").append(bid.fund).push_back('\n');
+}
+
+/**
+ * Write many bids as displayBid lines in one go. The bids are split into
+ * one contiguous run per thread, each thread formats its run into its own
+ * buffer, and the buffers are written in order, so the output is the
+ * same as printing the bids one by one.
+ *
+ * @param out Stream to write to; flushed at the end
+ * @param bids The bids, in output order
+ * @param threads Formatting threads, 0 for one per hardware thread; small
+ *        inputs use fewer
+ */
+void writeBids(ostream& out, span<const Bid* const> bids, unsigned int threads) {
+    // fewer bids per thread are not worth starting a thread for
+    const size_t BIDS_PER_THREAD = 16384;
+
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned int>(min<size_t>(threads, bids.size() / BIDS_PER_THREAD + 1));
+
+    vector<string> buffers(threads);
+    vector<exception_ptr> errors(threads);
+    auto format = [&bids, &buffers, &errors, threads](size_t t) {
+        try {
+            size_t first = bids.size() * t / threads;
+            size_t last = bids.size() * (t + 1) / threads;
+            string& buffer = buffers[t];
+            buffer.reserve((last - first) * 64);
+            for (size_t i = first; i < last; ++i) {
+                formatBid(buffer, *bids[i]);
+            }
+        } catch (...) {
+            errors[t] = current_exception();
+        }
+    };
+
+    vector<thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(format, t);
+    }
+    format(0);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    for (exception_ptr& error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+
+    for (const string& buffer : buffers) {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    }
+    out.flush();
+}
+
+/**
+ * Sort bids by bidId, in plain byte order of the ids. Each bid is sorted
+ * by its id's first 8 bytes, kept beside its pointer as one big-endian
+ * integer, and only ids sharing those are compared in full, so eBid's
+ * short ids are sorted without reading a bid.
+ */
+void sortById(span<const Bid*> bids) {
+    vector<pair<uint64_t, const Bid*>> keyed;
+    keyed.reserve(bids.size());
+    for (const Bid* bid : bids) {
+        uint64_t prefix = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            prefix <<= 8;
+            if (i < bid->bidId.size()) {
+                prefix |= static_cast<unsigned char>(bid->bidId[i]);
+            }
+        }
+        keyed.emplace_back(prefix, bid);
+    }
+    sort(keyed.begin(), keyed.end(), [](const auto& left, const auto& right) {
+        if (left.first != right.first) {
+            return left.first < right.first;
+        }
+        return left.second->bidId < right.second->bidId;
+    });
+    for (size_t i = 0; i < bids.size(); ++i) {
+        bids[i] = keyed[i].second;
+    }
+}
+
+/**
+ * Prompt user for bid information using console (std::in)
+ *
+ * @return Bid struct containing the bid info
+ */
+Bid getBid() {
+    Bid bid;
+
+    cout << "Enter Id: ";
+    cin.ignore();
+    getline(cin, bid.bidId);
+
+    cout << "Enter title: ";
+    getline(cin, bid.title);
+
+    cout << "Enter fund: ";
+    cin >> bid.fund;
+
+    cout << "Enter amount: ";
+    cin.ignore();
+    string strAmount;
+    getline(cin, strAmount);
+    bid.amount = strToDouble(strAmount, '$');
+
+    return bid;
+}
+
+/**
+ * Build a bid from one row of an eBid CSV file
+ *
+ * @param row The parsed CSV row
+ * @return Bid struct holding the row's bid info
+ */
+Bid bidFromRow(const csv::Row& row) {
+    return Bid(row[BID_ID_COLUMN], row[TITLE_COLUMN], row[FUND_COLUMN],
+            strToDouble(row[AMOUNT_COLUMN], '$'));
+}
+
+/**
+ * Simple C function to convert a string to a double
+ * after stripping out unwanted char
+ *
+ * credit: http://stackoverflow.com/a/24875936
+ *
+ * @param ch The character to strip out
+ */
+double strToDouble(string str, char ch) {
+    str.erase(remove(str.begin(), str.end(), ch), str.end());
+    return atof(str.c_str());
+}
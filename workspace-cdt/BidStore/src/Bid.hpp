@@ -0,0 +1,54 @@
+//============================================================================
+// Name        : Bid.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bid model shared by the bid container programs
+//============================================================================
+
+#ifndef BID_HPP_
+#define BID_HPP_
+
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <utility>
+
+#include "CSVparser.hpp"
+
+// define a structure to hold bid information
+struct Bid {
+    std::string bidId; // unique identifier
+    std::string title;
+    std::string fund;
+    double amount;
+    Bid() {
+        amount = 0.0;
+    }
+    Bid(std::string bidId, std::string title, std::string fund, double amount)
+        : bidId(std::move(bidId)), title(std::move(title)),
+          fund(std::move(fund)), amount(amount) {
+    }
+};
+
+// eBid CSV columns used to build a Bid
+const unsigned int TITLE_COLUMN = 0;
+const unsigned int BID_ID_COLUMN = 1;
+const unsigned int AMOUNT_COLUMN = 4;
+const unsigned int FUND_COLUMN = 8;
+
+// order in which a container writes out all of its bids
+enum class BidOrder {
+    Storage,	// the container's own order, fastest
+    ById		// sorted by bidId, so two dumps of the same bids diff cleanly
+};
+
+double strToDouble(std::string str, char ch);
+void displayBid(const Bid& bid);
+void formatBid(std::string& out, const Bid& bid);
+void writeBids(std::ostream& out, std::span<const Bid* const> bids, unsigned int threads = 0);
+void sortById(std::span<const Bid*> bids);
+Bid getBid();
+Bid bidFromRow(const csv::Row& row);
+
+#endif /* BID_HPP_ */
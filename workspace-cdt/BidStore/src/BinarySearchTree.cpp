@@ -0,0 +1,197 @@
+//============================================================================
+// Name        : BinarySearchTree.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Binary search tree of bids keyed by bidId
+//============================================================================
+
+#include "BinarySearchTree.hpp"
+
+using namespace std;
+
+/**
+ * Default constructor
+ */
+BinarySearchTree::BinarySearchTree() {
+    // initialize housekeeping variables
+	this->root = nullptr;
+}
+
+/**
+ * Destructor
+ */
+BinarySearchTree::~BinarySearchTree() {
+    // recurse from root deleting every node
+	this->destroy(this->root);
+}
+
+/**
+ * Traverse the tree in order
+ */
+void BinarySearchTree::InOrder() const {
+	this->ForEach(displayBid);
+}
+
+/**
+ * Insert a copy of a bid
+ */
+void BinarySearchTree::Insert(const Bid& bid) {
+	this->Insert(Bid(bid));
+}
+
+/**
+ * Insert a bid, moving its strings into the tree
+ */
+void BinarySearchTree::Insert(Bid&& bid) {
+    // FIXME (2a) Implement inserting a bid into the tree
+	if (this->root == nullptr) {		// tree is empty
+		this->root = new Node(std::move(bid));
+	} else {
+		// call to private recursive method that will systematically
+		// insert the bid in the intended order for the binary tree
+		this->addNode(root, std::move(bid));
+	}
+	return;
+}
+
+/**
+ * Remove a bid
+ */
+void BinarySearchTree::Remove(const string& bidId) {
+    // FIXME (4a) Implement removing a bid from the tree
+	this->root = this->removeNode(root, bidId);
+
+	return;
+}
+
+/**
+ * Find a bid without copying it
+ *
+ * @return pointer to the stored bid, nullptr if not found
+ */
+const Bid* BinarySearchTree::Find(const string& bidId) const {
+    // FIXME (3) Implement searching the tree for a bid
+
+	const Node* current = this->root;		// start at the root
+	while (current != nullptr) {
+		int comparison = current->bid.bidId.compare(bidId);
+		if (comparison == 0) {				// bidId matches
+			return &(current->bid);
+		} else {
+			// bidId is less than current node, move down the left side
+			if (comparison > 0) {
+				current = current->left;
+			}
+			// bidId is greater than current node, move down the right side
+			else {
+				current = current->right;
+			}
+		}
+	}
+
+    return nullptr;		// if reached, nothing was found
+}
+
+/**
+ * Search for a bid
+ *
+ * @return a copy of the bid, an empty bid if nothing was found
+ */
+Bid BinarySearchTree::Search(const string& bidId) const {
+	const Bid* found = this->Find(bidId);
+	return found != nullptr ? *found : Bid();
+}
+
+/**
+ * Add a bid to some node (recursive)
+ *
+ * @param node Current node in tree
+ * @param bid Bid to be added; only moved once its node is created
+ */
+void BinarySearchTree::addNode(Node* node, Bid&& bid) {
+    // FIXME (2b) Implement inserting a bid into the tree
+
+	// bidId is less than current node, make it a left subtree node
+	if (node->bid.bidId.compare(bid.bidId) > 0) {
+		if (node->left == nullptr) {		// no left subtree node, assign bid there in a new node
+			node->left = new Node(std::move(bid));
+		} else {							// a left node exists, go deeper in the tree
+			this->addNode(node->left, std::move(bid));	// recursive call with current left sub node as start
+		}
+	}
+	// bidId is greater than current node, make it a right subtree node
+	else {
+		if (node->right == nullptr) {			// no right subtree node, assign bid there in a new node
+			node->right = new Node(std::move(bid));
+		} else {								// a right node exists, go deeper in tree
+			this->addNode(node->right, std::move(bid));	// recursive call with current right sub node as start
+		}
+	}
+
+	return;
+}
+
+/**
+ * Delete a subtree (recursive, post-order)
+ *
+ * @param node Root of the subtree to delete
+ */
+void BinarySearchTree::destroy(Node* node) {
+	if (node == nullptr) {
+		return;
+	}
+	this->destroy(node->left);
+	this->destroy(node->right);
+	delete node;
+}
+
+Node* BinarySearchTree::removeNode(Node* node, const string& bidId) {
+	Node* temp = nullptr;			// temp node for swapping
+
+	// if tree is empty, return the nullptr
+	if (node == nullptr) {
+		return node;
+	}
+
+	// bidId is less than current node, traverse the left subtree node
+	if (node->bid.bidId.compare(bidId) > 0) {
+		node->left = removeNode(node->left, bidId);
+	}
+	// bidId is greater than current node, traverse the right subtree node
+	else if (node->bid.bidId.compare(bidId) < 0) {
+		node->right = removeNode(node->right, bidId);
+	}
+	// bidId matches, remove the node
+	else {
+		// node has no children
+		if (node->left == nullptr && node->right == nullptr) {
+			delete node;
+			node = nullptr;
+		}
+		// node has a left child, the child takes this node's place
+		else if (node->left != nullptr && node->right == nullptr) {
+			temp = node;
+			node = node->left;
+			delete temp;
+		}
+		// node has a right child, the child takes this node's place
+		else if (node->left == nullptr && node->right != nullptr) {
+			temp = node;
+			node = node->right;
+			delete temp;
+		}
+		// node has 2 children
+		// find the left most leaf of the right subtree
+		else {
+			temp = node->right;
+			while (temp->left != nullptr) {
+				temp = temp->left;
+			}
+			node->bid = temp->bid;
+			node->right = removeNode(node->right, temp->bid.bidId);
+		}
+	}
+
+	return node;
+}
@@ -0,0 +1,107 @@
+//============================================================================
+// Name        : BinarySearchTree.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Binary search tree of bids keyed by bidId
+//============================================================================
+
+#ifndef BINARYSEARCHTREE_HPP_
+#define BINARYSEARCHTREE_HPP_
+
+#include <string>
+#include <utility>
+
+#include "Bid.hpp"
+
+// FIXME (1): Internal structure for tree node
+// Binary tree nodes have up to two child nodes- left and right
+struct Node {
+	Bid bid;		// the node's present bid
+	// pointers to left and right nodes
+	Node* left;
+	Node* right;
+
+	// default constructor
+	Node() {
+		this->left = nullptr;
+		this->right = nullptr;
+	}
+
+	// construct Node when given a Bid argument, taking over its storage
+	Node(Bid&& bid)
+		: bid(std::move(bid)), left(nullptr), right(nullptr) {
+	}
+};
+
+//============================================================================
+// Binary Search Tree class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to
+ * implement a binary search tree
+ */
+class BinarySearchTree {
+
+private:
+    Node* root;
+
+    void addNode(Node* node, Bid&& bid);
+    void destroy(Node* node);
+    template<typename Visitor>
+    static void inOrder(const Node* node, Visitor& visit);
+    Node* removeNode(Node* node, const std::string& bidId);
+
+public:
+    BinarySearchTree();
+    virtual ~BinarySearchTree();
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void InOrder() const;
+    void Insert(const Bid& bid);
+    void Insert(Bid&& bid);
+    template<typename... Args>
+    void Emplace(Args&&... args);
+    void Remove(const std::string& bidId);
+    const Bid* Find(const std::string& bidId) const;
+    Bid Search(const std::string& bidId) const;
+};
+
+/**
+ * Build a bid from its fields and insert it by move
+ */
+template<typename... Args>
+void BinarySearchTree::Emplace(Args&&... args) {
+	this->Insert(Bid(std::forward<Args>(args)...));
+}
+
+/**
+ * Call visit(const Bid&) for every bid in bidId order
+ *
+ * @param visit Function or lambda to call with each bid
+ */
+template<typename Visitor>
+void BinarySearchTree::ForEach(Visitor visit) const {
+	inOrder(this->root, visit);
+}
+
+/**
+ * Visit a subtree in bidId order (recursive)
+ *
+ * @param node Root of the subtree to visit
+ * @param visit Function or lambda to call with each bid
+ */
+template<typename Visitor>
+void BinarySearchTree::inOrder(const Node* node, Visitor& visit) {
+	if (node == nullptr) {
+		return;
+	}
+	inOrder(node->left, visit);
+	visit(node->bid);
+	inOrder(node->right, visit);
+}
+
+#endif /* BINARYSEARCHTREE_HPP_ */
@@ -0,0 +1,45 @@
+//============================================================================
+// Name        : BloomFilter.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Blocked Bloom filter for fast negative membership tests
+//============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "BloomFilter.hpp"
+
+using namespace std;
+
+/**
+ * An empty filter
+ *
+ * @param capacity Number of keys it is sized for; more can be added, at a
+ *        rising false positive rate
+ * @param bitsPerKey Filter bits per key at capacity
+ */
+BlockedBloomFilter::BlockedBloomFilter(size_t capacity, double bitsPerKey) {
+    size_t bits = static_cast<size_t>(ceil(capacity * bitsPerKey));
+    size_t blockBits = sizeof(Block) * 8;
+    this->blocks.assign(max<size_t>(1, (bits + blockBits - 1) / blockBits), Block{});
+    this->capacity = capacity;
+}
+
+void BlockedBloomFilter::Clear() {
+    fill(this->blocks.begin(), this->blocks.end(), Block{});
+    this->count = 0;
+}
+
+size_t BlockedBloomFilter::Capacity() const {
+    return this->capacity;
+}
+
+size_t BlockedBloomFilter::Count() const {
+    return this->count;
+}
+
+size_t BlockedBloomFilter::Bytes() const {
+    return this->blocks.size() * sizeof(Block);
+}
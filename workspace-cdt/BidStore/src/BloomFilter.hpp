@@ -0,0 +1,103 @@
+//============================================================================
+// Name        : BloomFilter.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Blocked Bloom filter for fast negative membership tests
+//============================================================================
+
+#ifndef BLOOMFILTER_HPP_
+#define BLOOMFILTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//============================================================================
+// Blocked Bloom Filter class definition
+//============================================================================
+
+/**
+ * A split-block Bloom filter: a set of 64-bit hashes that answers "not
+ * present" for certain and "maybe present" with a small false positive
+ * rate.
+ *
+ * Each hash selects one 32-byte block (half a cache line, aligned) and
+ * sets one bit in each of the block's eight 32-bit words, the bit chosen
+ * by multiplying the hash's low half by a per-word odd constant. A test
+ * reads that one block and nothing else, so it costs at most one cache
+ * miss however many bits are checked. At the default 12 bits per key
+ * about 0.5% of absent keys pass.
+ *
+ * Keys cannot be removed; a filter holding keys that have gone only
+ * lets more absent keys through, and is rebuilt by its owner.
+ */
+class BlockedBloomFilter {
+
+private:
+    static constexpr size_t WORDS_PER_BLOCK = 8;
+
+    struct alignas(32) Block {
+        uint32_t words[WORDS_PER_BLOCK];
+    };
+
+    std::vector<Block> blocks;
+    size_t capacity = 0;		// keys it was sized for
+    size_t count = 0;			// keys added since it was built
+
+    size_t blockOf(uint64_t hash) const;
+    static uint32_t bitOf(uint64_t hash, size_t word);
+
+public:
+    static constexpr double DEFAULT_BITS_PER_KEY = 12.0;
+
+    explicit BlockedBloomFilter(size_t capacity = 0, double bitsPerKey = DEFAULT_BITS_PER_KEY);
+    void Add(uint64_t hash);
+    bool MayContain(uint64_t hash) const;
+    void Clear();
+    size_t Capacity() const;
+    size_t Count() const;
+    size_t Bytes() const;
+};
+
+/**
+ * The block of a hash, from its high half, mapped onto the block count
+ * with a multiply instead of a division
+ */
+inline size_t BlockedBloomFilter::blockOf(uint64_t hash) const {
+    return static_cast<size_t>(((hash >> 32) * this->blocks.size()) >> 32);
+}
+
+/**
+ * The bit of a hash in one word of its block, from its low half
+ */
+inline uint32_t BlockedBloomFilter::bitOf(uint64_t hash, size_t word) {
+    static constexpr uint32_t SALTS[WORDS_PER_BLOCK] = {
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+    };
+    return uint32_t(1) << ((static_cast<uint32_t>(hash) * SALTS[word]) >> 27);
+}
+
+inline void BlockedBloomFilter::Add(uint64_t hash) {
+    Block& block = this->blocks[this->blockOf(hash)];
+    for (size_t word = 0; word < WORDS_PER_BLOCK; ++word) {
+        block.words[word] |= bitOf(hash, word);
+    }
+    ++this->count;
+}
+
+/**
+ * @return false if the hash was certainly never added
+ */
+inline bool BlockedBloomFilter::MayContain(uint64_t hash) const {
+    const Block& block = this->blocks[this->blockOf(hash)];
+    uint32_t missing = 0;
+    for (size_t word = 0; word < WORDS_PER_BLOCK; ++word) {
+        uint32_t bit = bitOf(hash, word);
+        missing |= (block.words[word] & bit) ^ bit;
+    }
+    return missing == 0;
+}
+
+#endif /* BLOOMFILTER_HPP_ */
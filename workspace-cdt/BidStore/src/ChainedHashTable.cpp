@@ -0,0 +1,359 @@
+//============================================================================
+// Name        : ChainedHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table with chaining for bids
+//============================================================================
+
+#include <iostream>
+#include <vector>
+
+#include "ChainedHashTable.hpp"
+
+using namespace std;
+
+namespace {
+
+/**
+ * Smallest prime greater than or equal to n, by trial division (called
+ * once per resize, so this is cheap next to the rehash itself)
+ */
+unsigned int nextPrime(unsigned int n) {
+	if (n <= 2) {
+		return 2;
+	}
+	for (unsigned int candidate = n | 1; ; candidate += 2) {
+		bool prime = true;
+		for (unsigned int divisor = 3; divisor <= candidate / divisor; divisor += 2) {
+			if (candidate % divisor == 0) {
+				prime = false;
+				break;
+			}
+		}
+		if (prime) {
+			return candidate;
+		}
+	}
+}
+
+}
+
+/**
+ * Default constructor
+ */
+ChainedHashTable::ChainedHashTable() {
+    // (2): Initialize the structures used to hold bids
+	bidNodes.resize(tableSize);					// resize the vector to the desired size
+}
+
+/**
+ * Destructor
+ */
+ChainedHashTable::~ChainedHashTable() {
+    // (3): Implement logic to free storage when class is destroyed
+	// bucket heads live in the vector, the chained nodes in the pool. The
+	// pool's blocks go all at once; only the bids need destroying one by one.
+	for (BidNode& head : this->bidNodes) {
+		BidNode* chainNode = head.next;
+		while (chainNode != nullptr) {
+			BidNode* nextNode = chainNode->next;
+			chainNode->~BidNode();
+			chainNode = nextNode;
+		}
+	}
+	this->nodePool.Release();
+	return;
+}
+
+/**
+ * Calculate the bucket of a given bid id.
+ * The id is hashed with hashBidId rather than taken through atoi, so ids
+ * that are not numbers spread over the buckets as well.
+ *
+ * @param bidId The bid id to hash
+ * @return The calculated hash
+ */
+unsigned int ChainedHashTable::hash(const string& bidId) const {
+    // (4): Implement logic to calculate a hash value
+	// use modulo division to return the remainder of the hash by hash table size
+	return static_cast<unsigned int>(hashBidId(bidId) % this->tableSize);
+}
+
+/**
+ * Insert a copy of a bid
+ *
+ * @param bid The bid to insert
+ */
+void ChainedHashTable::Insert(const Bid& bid) {
+	this->Insert(Bid(bid));
+}
+
+/**
+ * Insert a bid, moving its strings into the table
+ *
+ * @param bid The bid to insert
+ */
+void ChainedHashTable::Insert(Bid&& bid) {
+	// grow before the average chain would pass one node
+	if (this->bidCount + 1 > this->tableSize) {
+		this->rehash(nextPrime(this->tableSize * 2));
+	}
+	this->addBid(std::move(bid));
+	++this->bidCount;
+	this->counters.Insert();
+}
+
+/**
+ * Add a bid to the end of its bucket's chain
+ *
+ * @param bid The bid to add
+ */
+void ChainedHashTable::addBid(Bid&& bid) {
+    // (5): Implement logic to insert a bid
+
+	// create the key- a hash of the bid's bidId
+	// key denotes bucket in the table to insert the bid
+	unsigned int key = this->hash(bid.bidId);
+
+	// check whether the bucket presently holds data
+	// if it does, chain a linked list together
+	BidNode* keyNode = &(this->bidNodes.at(key));		// desired node bucket
+
+	if (keyNode->key == DEFAULT_KEY) {					// Bucket has an unused node, replace it
+		keyNode->key = key;								// with populated node for this bid
+		keyNode->bid = std::move(bid);
+		keyNode->next = nullptr;
+	} else {											// Chain the nodes in the desired bucket
+		while (keyNode->next != nullptr) {				// iterate to the end of the chain
+			keyNode = keyNode->next;
+		}
+		keyNode->next = this->nodePool.New(std::move(bid), key);	// append a new node with bid to end of last node
+	}
+
+	return;
+}
+
+/**
+ * Move an existing chain node into its bucket in the resized table,
+ * reusing the allocation unless the bucket head is free
+ *
+ * @param node Pooled node taken from the old table
+ */
+void ChainedHashTable::relinkNode(BidNode* node) {
+	unsigned int key = this->hash(node->bid.bidId);
+	BidNode* headNode = &(this->bidNodes[key]);
+
+	if (headNode->key == DEFAULT_KEY) {					// bucket unused, the head takes the bid
+		headNode->key = key;
+		headNode->bid = std::move(node->bid);
+		headNode->next = nullptr;
+		this->nodePool.Delete(node);
+	} else {											// order within a chain does not matter
+		node->key = key;
+		node->next = headNode->next;
+		headNode->next = node;
+	}
+}
+
+/**
+ * Redistribute every bid over a new number of buckets
+ *
+ * @param newSize The new bucket count
+ */
+void ChainedHashTable::rehash(unsigned int newSize) {
+	vector<BidNode> oldNodes(newSize);
+	swap(oldNodes, this->bidNodes);
+	this->tableSize = newSize;
+	this->counters.Rehash();
+
+	for (BidNode& head : oldNodes) {
+		if (head.key == DEFAULT_KEY) {					// bucket is unused
+			continue;
+		}
+		BidNode* chainNode = head.next;
+		this->addBid(std::move(head.bid));				// heads live in the old vector
+		while (chainNode != nullptr) {
+			BidNode* nextNode = chainNode->next;
+			this->relinkNode(chainNode);
+			chainNode = nextNode;
+		}
+	}
+}
+
+/**
+ * Print all bids
+ */
+void ChainedHashTable::PrintAll() const {
+    // (6): Implement logic to print all bids
+	// Iterate over each index in the vector and loop through
+	// potential chains, collecting the bids, then write them in one go
+	vector<const Bid*> bids;
+	bids.reserve(this->bidCount);
+	this->ForEach([&bids](const Bid& bid) {
+		bids.push_back(&bid);
+	});
+	writeBids(cout, bids);
+
+	return;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool ChainedHashTable::Remove(const string& bidId) {
+    // (7): Implement logic to remove a bid
+	unsigned int key = this->hash(bidId);		// the key for the bidId passed in
+
+	BidNode* headNode = &(this->bidNodes.at(key));
+
+	if (headNode->key == DEFAULT_KEY) {						// bucket is unused
+	   	return false;
+	}
+
+	if (headNode->bid.bidId.compare(bidId) == 0) {			// bucket head matches
+		// the head node is stored in the vector, so pull the next node
+		// of the chain into it (or mark the bucket unused) instead of
+		// deleting it
+		BidNode* nextNode = headNode->next;
+		if (nextNode != nullptr) {
+			headNode->bid = std::move(nextNode->bid);
+			headNode->next = nextNode->next;
+			this->nodePool.Delete(nextNode);
+		} else {
+			headNode->bid = Bid();
+			headNode->key = DEFAULT_KEY;
+		}
+		--this->bidCount;
+		this->counters.Remove();
+		return true;
+	}
+
+	BidNode* previousNode = headNode;						// bid is buried in the chain
+	while (previousNode->next != nullptr) {
+		BidNode* searchNode = previousNode->next;
+		if (searchNode->bid.bidId.compare(bidId) == 0) {	// unlink the node, then free it
+			previousNode->next = searchNode->next;
+			this->nodePool.Delete(searchNode);
+			--this->bidCount;
+			this->counters.Remove();
+			return true;
+		}
+		previousNode = searchNode;
+	}
+
+	return false;
+}
+
+/**
+ * Find the specified bidId without copying the bid
+ *
+ * @param bidId The bid id to search for
+ * @return pointer to the stored bid, nullptr if not found. The pointer
+ *         stays valid until the bid is removed.
+ */
+const Bid* ChainedHashTable::Find(const string& bidId) const {
+    // (8): Implement logic to search for and return a bid
+    unsigned int key = this->hash(bidId);	// the key for the bidId passed in
+
+    const BidNode* searchNode = &(this->bidNodes.at(key));
+
+    if (searchNode->key == DEFAULT_KEY) {					// bucket is unused
+    	this->counters.Lookup(false);
+    	return nullptr;
+    }
+
+    size_t visited = 0;
+    while (searchNode != nullptr) {							// walk the chain from the head
+    	++visited;
+    	if (searchNode->bid.bidId.compare(bidId) == 0) {	// node matches, return the bid
+    		this->counters.Lookup(true);
+    		this->counters.Probe(visited);
+    		return &(searchNode->bid);
+    	}
+    	searchNode = searchNode->next;
+    }
+
+    this->counters.Lookup(false);
+    this->counters.Probe(visited);
+    return nullptr;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid ChainedHashTable::Search(const string& bidId) const {
+    const Bid* found = this->Find(bidId);
+    return found != nullptr ? *found : Bid();
+}
+
+/**
+ * Size the table for a number of bids up front, e.g. from the row count
+ * of a CSV file, so loading it never rehashes
+ *
+ * @param count Number of bids expected
+ */
+void ChainedHashTable::Reserve(size_t count) {
+	if (count > this->tableSize) {
+		this->rehash(nextPrime(static_cast<unsigned int>(count)));
+	}
+	// with one bucket per bid, about 3 in 8 bids land behind a bucket head
+	this->nodePool.Reserve(count * 3 / 8);
+}
+
+/**
+ * @return the number of bids in the table
+ */
+size_t ChainedHashTable::Size() const {
+	return this->bidCount;
+}
+
+/**
+ * @return the number of buckets
+ */
+size_t ChainedHashTable::BucketCount() const {
+	return this->tableSize;
+}
+
+/**
+ * Report how the bids sit in the buckets: an entry's probe length is its
+ * position in its chain, and the most loaded buckets are the longest
+ * chains
+ *
+ * @param hotCount How many of the longest chains to list
+ */
+TableStats ChainedHashTable::Stats(size_t hotCount) const {
+	TableStats stats;
+	stats.entries = this->bidCount;
+	stats.buckets = this->tableSize;
+
+	vector<pair<size_t, size_t>> bucketLoads;
+	for (size_t bucket = 0; bucket < this->bidNodes.size(); ++bucket) {
+		const BidNode& head = this->bidNodes[bucket];
+		if (head.key == DEFAULT_KEY) {					// bucket is unused
+			++stats.emptyBuckets;
+			continue;
+		}
+		size_t length = 0;
+		for (const BidNode* chainNode = &head; chainNode != nullptr;
+				chainNode = chainNode->next) {
+			stats.AddProbe(length++);
+		}
+		if (length > 1) {
+			bucketLoads.emplace_back(bucket, length);
+		}
+	}
+
+	// heads live in the vector, chained nodes in the pool's blocks
+	stats.memoryBytes = sizeof(*this) + this->bidNodes.capacity() * sizeof(BidNode)
+			+ this->nodePool.BlockCount() * NodePool<BidNode>::NODES_PER_BLOCK * sizeof(BidNode);
+	stats.counts = this->counters.Snapshot();
+	stats.Finish(std::move(bucketLoads), hotCount);
+	return stats;
+}
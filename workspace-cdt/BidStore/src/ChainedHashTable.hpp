@@ -0,0 +1,124 @@
+//============================================================================
+// Name        : ChainedHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table with chaining for bids
+//============================================================================
+
+#ifndef CHAINEDHASHTABLE_HPP_
+#define CHAINEDHASHTABLE_HPP_
+
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Bid.hpp"
+#include "HashFunctions.hpp"
+#include "NodePool.hpp"
+#include "TableStats.hpp"
+
+const unsigned int DEFAULT_SIZE = 179;
+const unsigned int DEFAULT_KEY = UINT_MAX;			// max unsigned int value
+
+//============================================================================
+// Hash Table class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to
+ * implement a hash table with chaining.
+ *
+ * The table grows to the next prime of at least twice its size whenever
+ * the bids outnumber the buckets, so chains stay short at any data size.
+ * Chained nodes come from a NodePool, which reuses removed nodes and
+ * frees them all a block at a time.
+ */
+class ChainedHashTable {
+
+private:
+    //(1): Define structures to hold bids
+	struct BidNode {
+		Bid bid;
+		unsigned int key;		// key value for hashing
+		BidNode* next;			// for implementing collision chaining
+
+		// default constructor
+		BidNode() {
+			this->key = DEFAULT_KEY;
+			this->next = nullptr;
+		}
+
+		// initialize with a bid and a key, taking over the bid's storage
+		BidNode(Bid&& bid, unsigned int key)
+			: bid(std::move(bid)), key(key), next(nullptr) {
+		}
+	};
+
+	std::vector<BidNode> bidNodes;		// vector to hold bid nodes
+	NodePool<BidNode> nodePool;			// storage for the chained nodes
+
+	// Define the hash table size for the modulo hash algorithm
+	// DEFAULT_SIZE is 179 (smaller monthly file for testing)
+	unsigned int tableSize = DEFAULT_SIZE;
+	size_t bidCount = 0;
+	[[no_unique_address]] mutable OperationCounters counters;	// empty unless BIDSTORE_STATS
+
+    unsigned int hash(const std::string& bidId) const;
+	void addBid(Bid&& bid);
+	void relinkNode(BidNode* node);
+	void rehash(unsigned int newSize);
+
+public:
+    ChainedHashTable();
+    virtual ~ChainedHashTable();
+    ChainedHashTable(const ChainedHashTable&) = delete;
+    ChainedHashTable& operator=(const ChainedHashTable&) = delete;
+    void Insert(const Bid& bid);
+    void Insert(Bid&& bid);
+    template<typename... Args>
+    void Emplace(Args&&... args);
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void PrintAll() const;
+    bool Remove(const std::string& bidId);
+    const Bid* Find(const std::string& bidId) const;
+    Bid Search(const std::string& bidId) const;
+    void Reserve(size_t count);
+    size_t Size() const;
+    size_t BucketCount() const;
+    TableStats Stats(size_t hotCount = 10) const;
+};
+
+/**
+ * Build a bid from its fields and insert it by move
+ *
+ * @param args Arguments forwarded to the Bid constructor
+ */
+template<typename... Args>
+void ChainedHashTable::Emplace(Args&&... args) {
+	this->Insert(Bid(std::forward<Args>(args)...));
+}
+
+/**
+ * Call visit(const Bid&) for every bid, bucket by bucket and along
+ * each bucket's chain
+ *
+ * @param visit Function or lambda to call with each bid
+ */
+template<typename Visitor>
+void ChainedHashTable::ForEach(Visitor visit) const {
+	for (const BidNode& head : this->bidNodes) {
+		if (head.key == DEFAULT_KEY) {					// bucket is unused
+			continue;
+		}
+		for (const BidNode* chainNode = &head; chainNode != nullptr;
+				chainNode = chainNode->next) {
+			visit(chainNode->bid);
+		}
+	}
+}
+
+#endif /* CHAINEDHASHTABLE_HPP_ */
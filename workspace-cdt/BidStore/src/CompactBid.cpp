@@ -0,0 +1,312 @@
+//============================================================================
+// Name        : CompactBid.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Compact bid record shared by the bid containers
+//============================================================================
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "CompactBid.hpp"
+
+using namespace std;
+
+//============================================================================
+// StringPool
+//============================================================================
+
+/**
+ * Append a string to the pool
+ *
+ * @param text The characters to copy into the pool
+ * @return the offset of the first character
+ */
+uint32_t StringPool::Append(string_view text) {
+    if (this->data.size() + text.size() > numeric_limits<uint32_t>::max()) {
+        throw length_error("StringPool: pool exceeds 4 GiB");
+    }
+
+    uint32_t offset = static_cast<uint32_t>(this->data.size());
+    this->data.insert(this->data.end(), text.begin(), text.end());
+    return offset;
+}
+
+/**
+ * View a string previously appended to the pool
+ */
+string_view StringPool::View(uint32_t offset, uint32_t length) const {
+    return string_view(this->data.data() + offset, length);
+}
+
+void StringPool::Reserve(size_t bytes) {
+    this->data.reserve(bytes);
+}
+
+size_t StringPool::Size() const {
+    return this->data.size();
+}
+
+size_t StringPool::Capacity() const {
+    return this->data.capacity();
+}
+
+//============================================================================
+// FundDictionary
+//============================================================================
+
+/**
+ * Return the code for a fund, assigning the next free code to funds
+ * that have not been seen before
+ *
+ * @param fund The fund name
+ * @return the code for the fund
+ */
+uint16_t FundDictionary::Intern(string_view fund) {
+    auto found = this->codes.find(fund);
+    if (found != this->codes.end()) {
+        return found->second;
+    }
+
+    if (this->names.size() > numeric_limits<uint16_t>::max()) {
+        throw length_error("FundDictionary: more than 65536 distinct funds");
+    }
+
+    uint16_t code = static_cast<uint16_t>(this->names.size());
+    this->names.emplace_back(fund);
+    try {
+        this->codes.emplace(this->names.back(), code);
+    } catch (...) {
+        this->names.pop_back();
+        throw;
+    }
+    return code;
+}
+
+/**
+ * Look up the code of a fund without interning it
+ *
+ * @return true if the fund is known, code is set to its code
+ */
+bool FundDictionary::Find(string_view fund, uint16_t& code) const {
+    auto found = this->codes.find(fund);
+    if (found == this->codes.end()) {
+        return false;
+    }
+    code = found->second;
+    return true;
+}
+
+const string& FundDictionary::Name(uint16_t code) const {
+    return this->names.at(code);
+}
+
+size_t FundDictionary::Size() const {
+    return this->names.size();
+}
+
+//============================================================================
+// BidCatalog
+//============================================================================
+
+/**
+ * Add a bid from already converted fields, replacing the bid with the
+ * same id if there is one
+ *
+ * @return the index of the bid in the catalog
+ */
+uint32_t BidCatalog::Add(uint32_t bidId, string_view title, string_view fund,
+        int64_t amountCents) {
+    CompactBid bid;
+    bid.amountCents = amountCents;
+    bid.bidId = bidId;
+    bid.titleOffset = this->titles.Append(title);
+    bid.titleLength = static_cast<uint32_t>(title.size());
+    bid.fundCode = this->funds.Intern(fund);
+
+    const uint32_t* existing = this->idIndex.Find(bidId);
+    if (existing != nullptr) {
+        this->bids[*existing] = bid;
+        return *existing;
+    }
+    uint32_t index = static_cast<uint32_t>(this->bids.size());
+    this->bids.push_back(bid);
+    try {
+        this->idIndex.Insert(bidId, index);
+    } catch (...) {
+        this->bids.pop_back();
+        throw;
+    }
+    return index;
+}
+
+/**
+ * Add a bid from the text fields of a CSV row
+ *
+ * @param bidId The numeric bid id as text
+ * @param amount The amount as text, e.g. "$1,234.56"
+ * @return the index of the new bid in the catalog
+ */
+uint32_t BidCatalog::Add(string_view bidId, string_view title,
+        string_view fund, string_view amount) {
+    uint32_t id;
+    if (!parseBidId(bidId, id)) {
+        throw invalid_argument("BidCatalog: bid id '" + string(bidId)
+                + "' is not numeric");
+    }
+    return this->Add(id, title, fund, parseCents(amount));
+}
+
+/**
+ * Pre-size the catalog for a known number of bids
+ *
+ * @param bidCount Number of bids that will be added
+ * @param titleBytes Total title bytes expected, if known
+ */
+void BidCatalog::Reserve(size_t bidCount, size_t titleBytes) {
+    this->bids.reserve(bidCount);
+    this->idIndex.Reserve(bidCount);
+    if (titleBytes > 0) {
+        this->titles.Reserve(titleBytes);
+    }
+}
+
+const CompactBid& BidCatalog::operator[](size_t index) const {
+    return this->bids[index];
+}
+
+/**
+ * Find the bid with an id
+ *
+ * @return pointer to the bid, nullptr if not found; valid until the next
+ *         Add
+ */
+const CompactBid* BidCatalog::Find(uint32_t bidId) const {
+    const uint32_t* index = this->idIndex.Find(bidId);
+    return index != nullptr ? &this->bids[*index] : nullptr;
+}
+
+/**
+ * Find the bid with an id given as text, e.g. "98109"
+ *
+ * @return pointer to the bid, nullptr if not found or not a valid id
+ */
+const CompactBid* BidCatalog::Find(string_view bidId) const {
+    uint32_t id;
+    return parseBidId(bidId, id) ? this->Find(id) : nullptr;
+}
+
+size_t BidCatalog::Size() const {
+    return this->bids.size();
+}
+
+string_view BidCatalog::Title(const CompactBid& bid) const {
+    return this->titles.View(bid.titleOffset, bid.titleLength);
+}
+
+const string& BidCatalog::Fund(const CompactBid& bid) const {
+    return this->funds.Name(bid.fundCode);
+}
+
+double BidCatalog::Amount(const CompactBid& bid) const {
+    return bid.amountCents / 100.0;
+}
+
+/**
+ * Expand a compact bid into an ordinary Bid
+ */
+Bid BidCatalog::ToBid(const CompactBid& bid) const {
+    return Bid(to_string(bid.bidId), string(this->Title(bid)), this->Fund(bid),
+            this->Amount(bid));
+}
+
+const FundDictionary& BidCatalog::Funds() const {
+    return this->funds;
+}
+
+/**
+ * Approximate number of bytes held by the catalog: records, title pool
+ * and id index (8-byte slots, and 16-byte entries of id, position and
+ * hash); the fund dictionary is negligible
+ */
+size_t BidCatalog::MemoryUsage() const {
+    return this->bids.capacity() * sizeof(CompactBid) + this->titles.Capacity()
+            + this->idIndex.Capacity() * 8 + this->idIndex.Size() * 16;
+}
+
+//============================================================================
+// Field conversion
+//============================================================================
+
+/**
+ * Convert a bid id such as "98109" to its numeric form. Only the
+ * canonical decimal form is accepted: "0123" is refused rather than read
+ * as 123, since two distinct ids would otherwise share one number.
+ *
+ * @return false if the text is empty, not all digits, has a leading zero
+ *         or overflows
+ */
+bool parseBidId(string_view text, uint32_t& bidId) {
+    if (text.empty() || (text.size() > 1 && text[0] == '0')) {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+        if (value > numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+    }
+
+    bidId = static_cast<uint32_t>(value);
+    return true;
+}
+
+/**
+ * Convert a currency amount such as "$1,234.56" to cents without going
+ * through a double. '$', ',' and quotes are skipped, fractional digits
+ * beyond cents are rounded half up.
+ *
+ * @param text The amount as text
+ * @return the amount in cents
+ */
+int64_t parseCents(string_view text) {
+    int64_t whole = 0;
+    int64_t fraction = 0;
+    int fractionDigits = 0;
+    bool negative = false;
+    bool inFraction = false;
+    bool roundUp = false;
+
+    for (char c : text) {
+        if (c == '-') {
+            negative = true;
+        } else if (c == '.') {
+            inFraction = true;
+        } else if (c >= '0' && c <= '9') {
+            if (!inFraction) {
+                whole = whole * 10 + (c - '0');
+            } else if (fractionDigits < 2) {
+                fraction = fraction * 10 + (c - '0');
+                ++fractionDigits;
+            } else if (fractionDigits == 2) {
+                roundUp = c >= '5';
+                ++fractionDigits;
+            }
+        }
+    }
+
+    while (fractionDigits < 2) {
+        fraction *= 10;
+        ++fractionDigits;
+    }
+
+    int64_t cents = whole * 100 + fraction + (roundUp ? 1 : 0);
+    return negative ? -cents : cents;
+}
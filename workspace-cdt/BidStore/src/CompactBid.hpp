@@ -0,0 +1,119 @@
+//============================================================================
+// Name        : CompactBid.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Compact bid record shared by the bid containers
+//============================================================================
+
+#ifndef COMPACTBID_HPP_
+#define COMPACTBID_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Bid.hpp"
+#include "HashFunctions.hpp"
+#include "HashMap.hpp"
+
+/**
+ * Compact, fixed-size bid record (24 bytes, no heap data of its own).
+ *
+ * The variable-length fields live in the owning BidCatalog: the title is
+ * an offset/length pair into the catalog's string pool and the fund is a
+ * code into its fund dictionary. The amount is stored in cents so no
+ * floating point rounding creeps in when bids are summed or compared.
+ */
+struct CompactBid {
+    int64_t amountCents;		// bid amount in cents (fixed-point)
+    uint32_t bidId;				// numeric bid identifier
+    uint32_t titleOffset;		// offset of the title in the string pool
+    uint32_t titleLength;		// length of the title in bytes
+    uint16_t fundCode;			// code of the fund in the fund dictionary
+};
+
+static_assert(sizeof(CompactBid) == 24, "CompactBid should stay 24 bytes");
+
+/**
+ * Append-only pool of characters; strings are referenced by offset/length
+ * so that many short titles share one contiguous allocation.
+ */
+class StringPool {
+
+private:
+    std::vector<char> data;
+
+public:
+    uint32_t Append(std::string_view text);
+    std::string_view View(uint32_t offset, uint32_t length) const;
+    void Reserve(size_t bytes);
+    size_t Size() const;
+    size_t Capacity() const;
+};
+
+/**
+ * Interns fund names into dense 16-bit codes. The eBid files only carry a
+ * handful of distinct funds, so each bid stores two bytes instead of a
+ * full string.
+ */
+class FundDictionary {
+
+private:
+    std::vector<std::string> names;						// code -> name
+    // name -> code; looked up by string_view without building a string
+    std::unordered_map<std::string, uint16_t, StringHash, std::equal_to<>> codes;
+
+public:
+    uint16_t Intern(std::string_view fund);
+    bool Find(std::string_view fund, uint16_t& code) const;
+    const std::string& Name(uint16_t code) const;
+    size_t Size() const;
+};
+
+/**
+ * A collection of compact bids together with the string pool and fund
+ * dictionary their fields refer to, indexed by bid id.
+ *
+ * The id index maps each numeric id to its record's position, 16 bytes
+ * per bid plus the slot array, so a lookup is one probe and one record
+ * read. Adding a bid whose id is already present replaces that record in
+ * place (its old title stays in the pool, unused).
+ */
+class BidCatalog {
+
+private:
+    std::vector<CompactBid> bids;
+    StringPool titles;
+    FundDictionary funds;
+    HashMap<uint32_t, uint32_t> idIndex;		// bid id -> position in bids
+
+public:
+    uint32_t Add(uint32_t bidId, std::string_view title, std::string_view fund,
+            int64_t amountCents);
+    uint32_t Add(std::string_view bidId, std::string_view title,
+            std::string_view fund, std::string_view amount);
+    void Reserve(size_t bidCount, size_t titleBytes = 0);
+
+    const CompactBid& operator[](size_t index) const;
+    const CompactBid* Find(uint32_t bidId) const;
+    const CompactBid* Find(std::string_view bidId) const;
+    size_t Size() const;
+
+    std::string_view Title(const CompactBid& bid) const;
+    const std::string& Fund(const CompactBid& bid) const;
+    double Amount(const CompactBid& bid) const;
+    Bid ToBid(const CompactBid& bid) const;
+
+    const FundDictionary& Funds() const;
+    size_t MemoryUsage() const;
+};
+
+bool parseBidId(std::string_view text, uint32_t& bidId);
+int64_t parseCents(std::string_view text);
+
+#endif /* COMPACTBID_HPP_ */
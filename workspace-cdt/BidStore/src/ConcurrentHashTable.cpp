@@ -0,0 +1,148 @@
+//============================================================================
+// Name        : ConcurrentHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Lock-striped hash table for bids shared between threads
+//============================================================================
+
+#include <algorithm>
+#include <bit>
+
+#include "ConcurrentHashTable.hpp"
+
+using namespace std;
+
+/**
+ * Default constructor
+ *
+ * @param stripeCount Number of stripes, rounded up to a power of two. A
+ *        few times the number of threads keeps writers from meeting.
+ */
+ConcurrentHashTable::ConcurrentHashTable(size_t stripeCount) {
+    stripeCount = bit_ceil(max<size_t>(stripeCount, 1));
+    this->stripes.reset(new Stripe[stripeCount]);
+    this->stripeMask = stripeCount - 1;
+}
+
+/**
+ * Destructor
+ */
+ConcurrentHashTable::~ConcurrentHashTable() {
+    // the stripes own everything
+}
+
+/**
+ * Pick the stripe of a bid id. Bits 32 and up of the hash are used: the
+ * stripe's own table takes its slot from the low bits and its
+ * fingerprint from bits 40 and up, so all three stay independent.
+ */
+ConcurrentHashTable::Stripe& ConcurrentHashTable::stripeFor(string_view bidId) {
+    return this->stripes[(hashBidId(bidId) >> 32) & this->stripeMask];
+}
+
+const ConcurrentHashTable::Stripe& ConcurrentHashTable::stripeFor(string_view bidId) const {
+    return this->stripes[(hashBidId(bidId) >> 32) & this->stripeMask];
+}
+
+/**
+ * Insert a bid; a bid with the same id replaces it
+ *
+ * @return true if the id was new
+ */
+bool ConcurrentHashTable::Insert(const Bid& bid) {
+    return this->Insert(Bid(bid));
+}
+
+bool ConcurrentHashTable::Insert(Bid&& bid) {
+    Stripe& stripe = this->stripeFor(bid.bidId);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    return stripe.table.Insert(std::move(bid));
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool ConcurrentHashTable::Remove(const string& bidId) {
+    Stripe& stripe = this->stripeFor(bidId);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    return stripe.table.Remove(bidId);
+}
+
+/**
+ * Copy the bid with an id
+ *
+ * @param bidId The bid id to search for
+ * @param bid Receives the bid if found
+ * @return true if found
+ */
+bool ConcurrentHashTable::Find(string_view bidId, Bid& bid) const {
+    return this->Visit(bidId, [&bid](const Bid& found) {
+        bid = found;
+    });
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid ConcurrentHashTable::Search(const string& bidId) const {
+    Bid bid;
+    this->Find(bidId, bid);
+    return bid;
+}
+
+/**
+ * Print all bids, stripe by stripe
+ */
+void ConcurrentHashTable::PrintAll() const {
+    this->ForEach(displayBid);
+}
+
+/**
+ * @return the number of bids; with concurrent writers, the sum of the
+ *         stripe sizes at the moments each was read
+ */
+size_t ConcurrentHashTable::Size() const {
+    size_t size = 0;
+    for (size_t i = 0; i <= this->stripeMask; ++i) {
+        shared_lock<shared_mutex> guard(this->stripes[i].lock);
+        size += this->stripes[i].table.Size();
+    }
+    return size;
+}
+
+/**
+ * Size every stripe for its share of a number of bids, plus some slack
+ * for uneven stripes
+ *
+ * @param count Number of bids expected
+ */
+void ConcurrentHashTable::Reserve(size_t count) {
+    size_t share = count / (this->stripeMask + 1);
+    share += share / 8 + 16;
+    for (size_t i = 0; i <= this->stripeMask; ++i) {
+        unique_lock<shared_mutex> guard(this->stripes[i].lock);
+        this->stripes[i].table.Reserve(share);
+    }
+}
+
+size_t ConcurrentHashTable::StripeCount() const {
+    return this->stripeMask + 1;
+}
+
+/**
+ * Spread each stripe's growth over its following writes, which shortens
+ * the time a growing stripe holds its write lock
+ */
+void ConcurrentHashTable::SetIncrementalGrowth(bool enabled) {
+    for (size_t i = 0; i <= this->stripeMask; ++i) {
+        unique_lock<shared_mutex> guard(this->stripes[i].lock);
+        this->stripes[i].table.SetIncrementalGrowth(enabled);
+    }
+}
@@ -0,0 +1,105 @@
+//============================================================================
+// Name        : ConcurrentHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Lock-striped hash table for bids shared between threads
+//============================================================================
+
+#ifndef CONCURRENTHASHTABLE_HPP_
+#define CONCURRENTHASHTABLE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include "Bid.hpp"
+#include "HashTable.hpp"
+
+//============================================================================
+// Concurrent Hash Table class definition
+//============================================================================
+
+/**
+ * A hash table of bids that any number of threads may use at once.
+ *
+ * The bids are split over a power-of-two number of stripes by bits of the
+ * id's hash. Each stripe is an ordinary HashTable behind its own
+ * reader/writer lock, so lookups in a stripe run in parallel, and writes
+ * only wait for threads working in the same stripe. Stripes are
+ * cache-line aligned, so threads on different stripes never share a line.
+ *
+ * Lookups return copies (or run a visitor under the stripe lock), since a
+ * pointer into a stripe could be invalidated by another thread's write.
+ */
+class ConcurrentHashTable {
+
+private:
+    struct alignas(64) Stripe {
+        mutable std::shared_mutex lock;
+        HashTable table;
+    };
+
+    std::unique_ptr<Stripe[]> stripes;
+    size_t stripeMask;
+
+    Stripe& stripeFor(std::string_view bidId);
+    const Stripe& stripeFor(std::string_view bidId) const;
+
+public:
+    explicit ConcurrentHashTable(size_t stripeCount = 64);
+    virtual ~ConcurrentHashTable();
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+    bool Insert(const Bid& bid);
+    bool Insert(Bid&& bid);
+    bool Remove(const std::string& bidId);
+    bool Find(std::string_view bidId, Bid& bid) const;
+    Bid Search(const std::string& bidId) const;
+    template<typename Visitor>
+    bool Visit(std::string_view bidId, Visitor visit) const;
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void PrintAll() const;
+    size_t Size() const;
+    void Reserve(size_t count);
+    size_t StripeCount() const;
+    void SetIncrementalGrowth(bool enabled);
+};
+
+/**
+ * Call visit(const Bid&) on the bid with an id, under the stripe's read
+ * lock, without copying the bid. The visitor must not call back into the
+ * table.
+ *
+ * @return false if the id is not in the table
+ */
+template<typename Visitor>
+bool ConcurrentHashTable::Visit(std::string_view bidId, Visitor visit) const {
+    const Stripe& stripe = this->stripeFor(bidId);
+    std::shared_lock<std::shared_mutex> guard(stripe.lock);
+    const Bid* bid = stripe.table.Find(bidId);
+    if (bid == nullptr) {
+        return false;
+    }
+    visit(*bid);
+    return true;
+}
+
+/**
+ * Call visit(const Bid&) for every bid, one stripe at a time. Each stripe
+ * is read-locked while it is visited, so writes to other stripes carry on
+ * and the walk is not a snapshot of the whole table.
+ */
+template<typename Visitor>
+void ConcurrentHashTable::ForEach(Visitor visit) const {
+    for (size_t i = 0; i <= this->stripeMask; ++i) {
+        std::shared_lock<std::shared_mutex> guard(this->stripes[i].lock);
+        this->stripes[i].table.ForEach(visit);
+    }
+}
+
+#endif /* CONCURRENTHASHTABLE_HPP_ */
@@ -0,0 +1,417 @@
+//============================================================================
+// Name        : CuckooHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bucketized cuckoo hash table for bids
+//============================================================================
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+#include "CuckooHashTable.hpp"
+
+using namespace std;
+
+namespace {
+
+/**
+ * Smallest bucket count that holds a number of bids below 90% full
+ */
+size_t bucketsFor(size_t count, size_t slotsPerBucket) {
+    size_t slots = count + count / 9 + 1;
+    return bit_ceil(max<size_t>(2, (slots + slotsPerBucket - 1) / slotsPerBucket));
+}
+
+}
+
+/**
+ * Default constructor
+ */
+CuckooHashTable::CuckooHashTable() {
+    this->buckets.assign(2, Bucket{});
+    this->mask = 1;
+}
+
+/**
+ * Destructor
+ */
+CuckooHashTable::~CuckooHashTable() {
+}
+
+// a hint only: compilers without the builtin simply do not prefetch
+void CuckooHashTable::prefetch(const void* address) {
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void) address;
+#endif
+}
+
+uint64_t CuckooHashTable::hash(string_view bidId) const {
+    return hashBytes(bidId.data(), bidId.size(), this->seed);
+}
+
+/**
+ * A bid's other bucket, from either of its buckets and its tag. Odd, so
+ * never the same bucket; an xor, so it maps each bucket to the other.
+ */
+size_t CuckooHashTable::alternate(size_t bucket, uint32_t tag) const {
+    return (bucket ^ (mixInteger(tag) | 1)) & this->mask;
+}
+
+/**
+ * Look an id up in its two buckets and the stash
+ *
+ * @return the index of its bid, or NOT_FOUND
+ */
+uint32_t CuckooHashTable::findIndex(string_view bidId, uint64_t hash) const {
+    uint32_t tag = static_cast<uint32_t>(hash >> 32);
+    size_t first = hash & this->mask;
+    size_t second = this->alternate(first, tag);
+    prefetch(&this->buckets[second]);		// both misses outstanding at once
+
+    const Bucket* candidates[2] = { &this->buckets[first], &this->buckets[second] };
+    for (size_t b = 0; b < 2; ++b) {
+        const Bucket& bucket = *candidates[b];
+        for (size_t slot = 0; slot < SLOTS_PER_BUCKET; ++slot) {
+            uint32_t entry = bucket.entries[slot];
+            if (bucket.tags[slot] == tag && entry != EMPTY
+                    && this->bids[entry - 1].bidId == bidId) {
+                this->counters.Probe(b + 1);
+                return entry - 1;
+            }
+        }
+    }
+    for (const StashEntry& stashed : this->stash) {
+        if (stashed.tag == tag && this->bids[stashed.index].bidId == bidId) {
+            this->counters.Probe(3);
+            return stashed.index;
+        }
+    }
+    this->counters.Probe(this->stash.empty() ? 2 : 3);
+    return NOT_FOUND;
+}
+
+/**
+ * The bucket entry or stash element that refers to a bid
+ *
+ * @param index The bid's index; the bid must be in the table
+ */
+uint32_t* CuckooHashTable::findEntry(uint32_t index) {
+    uint64_t hash = this->hash(this->bids[index].bidId);
+    size_t first = hash & this->mask;
+    size_t candidates[2] = { first, this->alternate(first, static_cast<uint32_t>(hash >> 32)) };
+    for (size_t b : candidates) {
+        for (uint32_t& entry : this->buckets[b].entries) {
+            if (entry == index + 1) {
+                return &entry;
+            }
+        }
+    }
+    for (StashEntry& stashed : this->stash) {
+        if (stashed.index == index) {
+            return &stashed.index;
+        }
+    }
+    return nullptr;
+}
+
+bool CuckooHashTable::inStash(const uint32_t* entry) const {
+    for (const StashEntry& stashed : this->stash) {
+        if (&stashed.index == entry) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * xorshift64, for picking eviction victims: they must vary, or two bids
+ * can evict each other back and forth forever
+ */
+uint64_t CuckooHashTable::nextRandom() {
+    this->kickState ^= this->kickState << 13;
+    this->kickState ^= this->kickState >> 7;
+    this->kickState ^= this->kickState << 17;
+    return this->kickState;
+}
+
+/**
+ * Put a bid's index into a free slot of one of its buckets, evicting
+ * other bids to their alternate buckets if both are full
+ *
+ * @return false if the walk ran out and the stash is full; one bid
+ *         (not necessarily this one) is then in no bucket, and the
+ *         table must be rebuilt
+ */
+bool CuckooHashTable::place(uint32_t index, uint64_t hash) {
+    uint32_t tag = static_cast<uint32_t>(hash >> 32);
+    uint32_t entry = index + 1;
+    size_t bucket = hash & this->mask;
+    size_t other = this->alternate(bucket, tag);
+    for (size_t b : { bucket, other }) {
+        for (size_t slot = 0; slot < SLOTS_PER_BUCKET; ++slot) {
+            if (this->buckets[b].entries[slot] == EMPTY) {
+                this->buckets[b].tags[slot] = tag;
+                this->buckets[b].entries[slot] = entry;
+                return true;
+            }
+        }
+    }
+
+    if ((this->nextRandom() & 1) != 0) {
+        bucket = other;
+    }
+    for (size_t kick = 0; kick < MAX_KICKS; ++kick) {
+        size_t victim = this->nextRandom() % SLOTS_PER_BUCKET;
+        swap(tag, this->buckets[bucket].tags[victim]);
+        swap(entry, this->buckets[bucket].entries[victim]);
+
+        bucket = this->alternate(bucket, tag);
+        for (size_t slot = 0; slot < SLOTS_PER_BUCKET; ++slot) {
+            if (this->buckets[bucket].entries[slot] == EMPTY) {
+                this->buckets[bucket].tags[slot] = tag;
+                this->buckets[bucket].entries[slot] = entry;
+                return true;
+            }
+        }
+    }
+
+    if (this->stash.size() < STASH_SIZE) {
+        this->stash.push_back(StashEntry{ tag, entry - 1, static_cast<uint32_t>(bucket) });
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Move stashed bids into any free slot of their buckets, so the stash
+ * empties as removals make room rather than only on the next rebuild
+ */
+void CuckooHashTable::drainStash() {
+    for (size_t i = this->stash.size(); i-- > 0; ) {
+        const StashEntry stashed = this->stash[i];
+        for (size_t b : { size_t(stashed.bucket), this->alternate(stashed.bucket, stashed.tag) }) {
+            Bucket& bucket = this->buckets[b];
+            size_t slot = 0;
+            while (slot < SLOTS_PER_BUCKET && bucket.entries[slot] != EMPTY) {
+                ++slot;
+            }
+            if (slot < SLOTS_PER_BUCKET) {
+                bucket.tags[slot] = stashed.tag;
+                bucket.entries[slot] = stashed.index + 1;
+                this->stash.erase(this->stash.begin() + i);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Place every bid again into a table of the given size, changing the
+ * hash seed until all of them fit
+ *
+ * @param bucketCount A power of two of at least 2; doubled if a seed
+ *        fails with the table more than half full, or several in a row
+ *        fail
+ */
+void CuckooHashTable::rebuild(size_t bucketCount) {
+    for (size_t failures = 1; ; ++failures) {
+        this->buckets.assign(bucketCount, Bucket{});
+        this->mask = bucketCount - 1;
+        this->stash.clear();
+        this->counters.Rehash();
+
+        bool placed = true;
+        for (size_t i = 0; i < this->bids.size() && placed; ++i) {
+            placed = this->place(static_cast<uint32_t>(i), this->hash(this->bids[i].bidId));
+        }
+        if (placed) {
+            return;
+        }
+        ++this->seed;
+        if (this->bids.size() * 2 > bucketCount * SLOTS_PER_BUCKET
+                || failures % MAX_SEEDS_PER_SIZE == 0) {
+            bucketCount *= 2;
+        }
+    }
+}
+
+/**
+ * Insert a bid, replacing any bid with the same id
+ *
+ * @param bid The bid to insert
+ * @return true if the id was new
+ */
+bool CuckooHashTable::Insert(const Bid& bid) {
+    return this->Insert(Bid(bid));
+}
+
+bool CuckooHashTable::Insert(Bid&& bid) {
+    uint32_t index = this->findIndex(bid.bidId, this->hash(bid.bidId));
+    if (index != NOT_FOUND) {
+        this->bids[index] = std::move(bid);
+        return false;
+    }
+    if (this->bids.size() >= UINT32_MAX - 1) {
+        throw length_error("CuckooHashTable: too many bids");
+    }
+
+    if ((this->bids.size() + 1) * 10 > this->Capacity() * 9) {
+        this->rebuild(this->buckets.size() * 2);
+    }
+    this->bids.push_back(std::move(bid));
+    index = static_cast<uint32_t>(this->bids.size() - 1);
+    if (!this->place(index, this->hash(this->bids[index].bidId))) {
+        this->rebuild(this->buckets.size());
+    }
+    this->counters.Insert();
+    return true;
+}
+
+/**
+ * Remove a bid. The last bid moves into its place.
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool CuckooHashTable::Remove(string_view bidId) {
+    uint32_t index = this->findIndex(bidId, this->hash(bidId));
+    if (index == NOT_FOUND) {
+        return false;
+    }
+
+    uint32_t* entry = this->findEntry(index);
+    if (this->inStash(entry)) {
+        this->stash.erase(find_if(this->stash.begin(), this->stash.end(),
+                [entry](const StashEntry& stashed) { return &stashed.index == entry; }));
+    } else {
+        *entry = EMPTY;
+    }
+
+    uint32_t last = static_cast<uint32_t>(this->bids.size() - 1);
+    if (index != last) {
+        uint32_t* moved = this->findEntry(last);
+        *moved = this->inStash(moved) ? index : index + 1;
+        this->bids[index] = std::move(this->bids[last]);
+    }
+    this->bids.pop_back();
+    if (!this->stash.empty()) {
+        this->drainStash();
+    }
+    this->counters.Remove();
+    return true;
+}
+
+/**
+ * Find the bid with an id without copying it
+ *
+ * @return pointer to the bid, nullptr if not found; valid until the next
+ *         Insert or Remove
+ */
+const Bid* CuckooHashTable::Find(string_view bidId) const {
+    uint32_t index = this->findIndex(bidId, this->hash(bidId));
+    this->counters.Lookup(index != NOT_FOUND);
+    return index != NOT_FOUND ? &this->bids[index] : nullptr;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid CuckooHashTable::Search(const string& bidId) const {
+    const Bid* bid = this->Find(bidId);
+    return bid != nullptr ? *bid : Bid();
+}
+
+void CuckooHashTable::PrintAll() const {
+    this->ForEach(displayBid);
+}
+
+size_t CuckooHashTable::Size() const {
+    return this->bids.size();
+}
+
+/**
+ * Size the table for a number of bids up front, so loading them never
+ * rehashes
+ *
+ * @param count Number of bids expected
+ */
+void CuckooHashTable::Reserve(size_t count) {
+    this->bids.reserve(count);
+    size_t needed = bucketsFor(count, SLOTS_PER_BUCKET);
+    if (needed > this->buckets.size()) {
+        this->rebuild(needed);
+    }
+}
+
+/**
+ * Rebuild at the smallest bucket count that holds the bids, and release
+ * the unused bid storage
+ */
+void CuckooHashTable::ShrinkToFit() {
+    this->bids.shrink_to_fit();
+    size_t needed = bucketsFor(this->bids.size(), SLOTS_PER_BUCKET);
+    if (needed < this->buckets.size()) {
+        this->rebuild(needed);
+        this->buckets.shrink_to_fit();
+    }
+}
+
+/**
+ * @return the number of bucket slots
+ */
+size_t CuckooHashTable::Capacity() const {
+    return this->buckets.size() * SLOTS_PER_BUCKET;
+}
+
+float CuckooHashTable::LoadFactor() const {
+    return static_cast<float>(this->bids.size()) / this->Capacity();
+}
+
+size_t CuckooHashTable::StashSize() const {
+    return this->stash.size();
+}
+
+/**
+ * Report how the bids sit in the buckets: an entry's probe length is 0
+ * in its first bucket, 1 in its alternate and 2 in the stash
+ *
+ * @param hotCount How many of the fullest buckets to list
+ */
+TableStats CuckooHashTable::Stats(size_t hotCount) const {
+    TableStats stats;
+    stats.entries = this->bids.size();
+    stats.buckets = this->buckets.size();
+
+    vector<pair<size_t, size_t>> bucketLoads;
+    for (size_t b = 0; b < this->buckets.size(); ++b) {
+        size_t load = 0;
+        for (uint32_t entry : this->buckets[b].entries) {
+            if (entry != EMPTY) {
+                ++load;
+                stats.AddProbe((this->hash(this->bids[entry - 1].bidId) & this->mask) == b ? 0 : 1);
+            }
+        }
+        if (load == 0) {
+            ++stats.emptyBuckets;
+        } else if (load > 1) {
+            bucketLoads.emplace_back(b, load);
+        }
+    }
+    for (size_t i = 0; i < this->stash.size(); ++i) {
+        stats.AddProbe(2);
+    }
+
+    stats.memoryBytes = sizeof(*this) + this->buckets.capacity() * sizeof(Bucket)
+            + this->stash.capacity() * sizeof(StashEntry) + this->bids.capacity() * sizeof(Bid);
+    stats.counts = this->counters.Snapshot();
+    stats.Finish(std::move(bucketLoads), hotCount);
+    return stats;
+}
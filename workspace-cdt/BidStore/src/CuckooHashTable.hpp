@@ -0,0 +1,133 @@
+//============================================================================
+// Name        : CuckooHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bucketized cuckoo hash table for bids
+//============================================================================
+
+#ifndef CUCKOOHASHTABLE_HPP_
+#define CUCKOOHASHTABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Bid.hpp"
+#include "HashFunctions.hpp"
+#include "TableStats.hpp"
+
+//============================================================================
+// Cuckoo Hash Table class definition
+//============================================================================
+
+/**
+ * A hash table of bids with a fixed worst case for lookups, for callers
+ * whose limit is on the slowest lookup rather than the average one.
+ *
+ * Every id has two candidate buckets of four slots, and a bid is always
+ * in one of them or in a small stash. A lookup checks the two buckets and,
+ * when it is not empty, the stash, and nothing else: no probe sequence or
+ * chain grows with unlucky or adversarial ids. Each bucket is 32 bytes,
+ * aligned, holding four 32-bit hash tags and four bid indexes, so the two
+ * buckets are at most two cache lines; both are requested before either
+ * is examined. Bid ids are compared only on a tag match, so a hit reads
+ * one bid and a miss almost never reads any.
+ *
+ * An insert into two full buckets evicts a bid to its other bucket,
+ * which may evict another, for a bounded number of kicks (random walk
+ * cuckoo). The alternate bucket is computed from the current bucket and
+ * the tag alone (partial-key cuckoo hashing), so moving a bid never
+ * rehashes its id. A walk that runs out puts its last bid in the stash,
+ * with its tag, so lookups compare ids there only on a tag match too;
+ * a Remove that frees a slot in a stashed bid's bucket moves the bid
+ * back out of the stash. When the stash is full too, the table rebuilds with a new hash seed,
+ * and doubles if it is more than half full (or a few seeds in a row have
+ * failed). It also doubles at 90% full, well before bucketized cuckoo
+ * tables start to fail.
+ *
+ * Bids are kept densely in insertion order. Removing one moves the last
+ * bid into its place, so pointers from Find are only valid until the next
+ * Insert or Remove. Removal empties the bid's slot outright; cuckoo
+ * lookups never probe past a slot, so no marker is needed. The buckets
+ * only shrink through ShrinkToFit.
+ */
+class CuckooHashTable {
+
+private:
+    static constexpr size_t SLOTS_PER_BUCKET = 4;
+    static constexpr size_t STASH_SIZE = 4;
+    static constexpr size_t MAX_KICKS = 256;
+    static constexpr size_t MAX_SEEDS_PER_SIZE = 4;
+    static constexpr uint32_t EMPTY = 0;		// entries hold bid index + 1
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    struct alignas(32) Bucket {
+        uint32_t tags[SLOTS_PER_BUCKET];		// upper half of each id's hash
+        uint32_t entries[SLOTS_PER_BUCKET];	// bid index + 1, or EMPTY
+    };
+
+    std::vector<Bucket> buckets;
+    // a bid that found no bucket
+    struct StashEntry {
+        uint32_t tag;
+        uint32_t index;						// bid index
+        uint32_t bucket;					// one of its two buckets
+    };
+
+    std::vector<StashEntry> stash;
+    std::vector<Bid> bids;
+    size_t mask = 0;					// bucket count - 1
+    uint64_t seed = 0;
+    uint64_t kickState = 0x9E3779B97F4A7C15ull;	// xorshift state picking victims
+    [[no_unique_address]] mutable OperationCounters counters;	// empty unless BIDSTORE_STATS
+
+    static void prefetch(const void* address);
+    uint64_t hash(std::string_view bidId) const;
+    size_t alternate(size_t bucket, uint32_t tag) const;
+    uint32_t findIndex(std::string_view bidId, uint64_t hash) const;
+    uint32_t* findEntry(uint32_t index);
+    bool inStash(const uint32_t* entry) const;
+    uint64_t nextRandom();
+    bool place(uint32_t index, uint64_t hash);
+    void drainStash();
+    void rebuild(size_t bucketCount);
+
+public:
+    CuckooHashTable();
+    virtual ~CuckooHashTable();
+    CuckooHashTable(const CuckooHashTable&) = delete;
+    CuckooHashTable& operator=(const CuckooHashTable&) = delete;
+    bool Insert(const Bid& bid);
+    bool Insert(Bid&& bid);
+    bool Remove(std::string_view bidId);
+    const Bid* Find(std::string_view bidId) const;
+    Bid Search(const std::string& bidId) const;
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void PrintAll() const;
+    size_t Size() const;
+    void Reserve(size_t count);
+    void ShrinkToFit();
+    size_t Capacity() const;
+    float LoadFactor() const;
+    size_t StashSize() const;
+    TableStats Stats(size_t hotCount = 10) const;
+};
+
+/**
+ * Call visit(const Bid&) for every bid, in insertion order (until a
+ * Remove moves the last bid)
+ *
+ * @param visit Function or lambda to call with each bid
+ */
+template<typename Visitor>
+void CuckooHashTable::ForEach(Visitor visit) const {
+    for (const Bid& bid : this->bids) {
+        visit(bid);
+    }
+}
+
+#endif /* CUCKOOHASHTABLE_HPP_ */
@@ -0,0 +1,270 @@
+//============================================================================
+// Name        : EpochHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Chained hash table for bids with lock-free lookups
+//============================================================================
+
+#include <algorithm>
+#include <bit>
+
+#include "EpochHashTable.hpp"
+
+using namespace std;
+
+EpochHashTable::Buckets::Buckets(size_t count)
+        : mask(count - 1), heads(new atomic<BidNode*>[count]) {
+    for (size_t i = 0; i < count; ++i) {
+        this->heads[i].store(nullptr, memory_order_relaxed);
+    }
+}
+
+EpochHashTable::Buckets::~Buckets() {
+    for (size_t i = 0; i <= this->mask; ++i) {
+        BidNode* node = this->heads[i].load(memory_order_relaxed);
+        while (node != nullptr) {
+            BidNode* next = node->next.load(memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+}
+
+/**
+ * Default constructor
+ *
+ * @param lockCount Number of writer locks, rounded up to a power of two;
+ *        also the smallest bucket count
+ */
+EpochHashTable::EpochHashTable(size_t lockCount) {
+    lockCount = bit_ceil(max<size_t>(lockCount, 1));
+    this->locks.reset(new WriteLock[lockCount]);
+    this->lockMask = lockCount - 1;
+    this->buckets.store(new Buckets(lockCount), memory_order_release);
+}
+
+/**
+ * Destructor. No other thread may be using the table; nodes retired
+ * earlier are freed by the epoch domain as usual.
+ */
+EpochHashTable::~EpochHashTable() {
+    delete this->buckets.load(memory_order_acquire);
+}
+
+/**
+ * Find the node of a bid id. The caller must be inside an EpochGuard.
+ */
+const EpochHashTable::BidNode* EpochHashTable::findNode(string_view bidId,
+        uint64_t hash) const {
+    const Buckets* current = this->buckets.load(memory_order_acquire);
+    const BidNode* node = current->heads[hash & current->mask].load(memory_order_acquire);
+    while (node != nullptr && (node->hash != hash || node->bid.bidId != bidId)) {
+        node = node->next.load(memory_order_acquire);
+    }
+    return node;
+}
+
+/**
+ * The writer lock of a hash. Bucket counts are powers of two no smaller
+ * than the lock count, so every bucket belongs to exactly one lock at any
+ * size.
+ */
+EpochHashTable::WriteLock& EpochHashTable::lockFor(uint64_t hash) {
+    return this->locks[hash & this->lockMask];
+}
+
+/**
+ * Replace the bucket array with a larger one. Readers may be walking the
+ * old chains, so they are copied rather than relinked, and the old array
+ * is retired with its nodes.
+ *
+ * @param bucketCount New bucket count, a power of two
+ */
+void EpochHashTable::grow(size_t bucketCount) {
+    for (size_t i = 0; i <= this->lockMask; ++i) {
+        this->locks[i].lock.lock();
+    }
+
+    Buckets* old = this->buckets.load(memory_order_acquire);
+    bool grown = bucketCount > old->mask + 1;	// another writer may have been first
+    if (grown) {
+        Buckets* larger = new Buckets(bucketCount);
+        for (size_t i = 0; i <= old->mask; ++i) {
+            for (BidNode* node = old->heads[i].load(memory_order_relaxed); node != nullptr;
+                    node = node->next.load(memory_order_relaxed)) {
+                atomic<BidNode*>& head = larger->heads[node->hash & larger->mask];
+                head.store(new BidNode(Bid(node->bid), node->hash,
+                        head.load(memory_order_relaxed)), memory_order_relaxed);
+            }
+        }
+        this->buckets.store(larger, memory_order_release);
+    }
+
+    for (size_t i = 0; i <= this->lockMask; ++i) {
+        this->locks[i].lock.unlock();
+    }
+    if (grown) {
+        retire(old);
+    }
+}
+
+/**
+ * Insert a bid; a bid with the same id is replaced by a new node
+ *
+ * @return true if the id was new
+ */
+bool EpochHashTable::Insert(const Bid& bid) {
+    return this->Insert(Bid(bid));
+}
+
+bool EpochHashTable::Insert(Bid&& bid) {
+    uint64_t hash = hashBidId(bid.bidId);
+    BidNode* node = new BidNode(std::move(bid), hash, nullptr);	// built outside the lock
+    BidNode* replaced = nullptr;
+    size_t growTo = 0;
+
+    WriteLock& writer = this->lockFor(hash);
+    {
+        lock_guard<mutex> guard(writer.lock);
+        Buckets* current = this->buckets.load(memory_order_acquire);
+        atomic<BidNode*>& head = current->heads[hash & current->mask];
+
+        atomic<BidNode*>* link = &head;
+        for (BidNode* existing = link->load(memory_order_relaxed); existing != nullptr;
+                existing = link->load(memory_order_relaxed)) {
+            if (existing->hash == hash && existing->bid.bidId == node->bid.bidId) {
+                replaced = existing;
+                break;
+            }
+            link = &existing->next;
+        }
+
+        if (replaced != nullptr) {
+            node->next.store(replaced->next.load(memory_order_relaxed), memory_order_relaxed);
+            link->store(node, memory_order_release);
+        } else {
+            node->next.store(head.load(memory_order_relaxed), memory_order_relaxed);
+            head.store(node, memory_order_release);
+
+            // grow at a load of about one bid per bucket; a lock's count
+            // runs a little ahead of the average, hence the margin
+            size_t count = writer.count.load(memory_order_relaxed) + 1;
+            writer.count.store(count, memory_order_relaxed);
+            size_t perLock = (current->mask + 1) / (this->lockMask + 1);
+            if (count > perLock + perLock / 4 + 4) {
+                growTo = (current->mask + 1) * 2;
+            }
+        }
+    }
+
+    if (replaced != nullptr) {
+        retire(replaced);
+        return false;
+    }
+    if (growTo != 0) {
+        this->grow(growTo);
+    }
+    return true;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool EpochHashTable::Remove(const string& bidId) {
+    uint64_t hash = hashBidId(bidId);
+    BidNode* removed = nullptr;
+
+    WriteLock& writer = this->lockFor(hash);
+    {
+        lock_guard<mutex> guard(writer.lock);
+        Buckets* current = this->buckets.load(memory_order_acquire);
+        atomic<BidNode*>* link = &current->heads[hash & current->mask];
+        for (BidNode* node = link->load(memory_order_relaxed); node != nullptr;
+                node = link->load(memory_order_relaxed)) {
+            if (node->hash == hash && node->bid.bidId == bidId) {
+                // readers on the node still reach the rest of the chain
+                link->store(node->next.load(memory_order_relaxed), memory_order_release);
+                writer.count.store(writer.count.load(memory_order_relaxed) - 1,
+                        memory_order_relaxed);
+                removed = node;
+                break;
+            }
+            link = &node->next;
+        }
+    }
+
+    if (removed == nullptr) {
+        return false;
+    }
+    retire(removed);
+    return true;
+}
+
+/**
+ * Find the bid with an id without copying it. The caller must hold an
+ * EpochGuard from before the call until it is done with the pointer.
+ *
+ * @return pointer to the bid, nullptr if not found
+ */
+const Bid* EpochHashTable::Find(string_view bidId) const {
+    const BidNode* node = this->findNode(bidId, hashBidId(bidId));
+    return node != nullptr ? &node->bid : nullptr;
+}
+
+/**
+ * Copy the bid with an id
+ *
+ * @param bidId The bid id to search for
+ * @param bid Receives the bid if found
+ * @return true if found
+ */
+bool EpochHashTable::Find(string_view bidId, Bid& bid) const {
+    return this->Visit(bidId, [&bid](const Bid& found) {
+        bid = found;
+    });
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid EpochHashTable::Search(const string& bidId) const {
+    Bid bid;
+    this->Find(bidId, bid);
+    return bid;
+}
+
+void EpochHashTable::PrintAll() const {
+    this->ForEach(displayBid);
+}
+
+/**
+ * @return the number of bids; with concurrent writers, an approximation
+ */
+size_t EpochHashTable::Size() const {
+    size_t size = 0;
+    for (size_t i = 0; i <= this->lockMask; ++i) {
+        size += this->locks[i].count.load(memory_order_relaxed);
+    }
+    return size;
+}
+
+/**
+ * Size the bucket array for a number of bids up front, so loading them
+ * never copies the chains
+ *
+ * @param count Number of bids expected
+ */
+void EpochHashTable::Reserve(size_t count) {
+    this->grow(bit_ceil(max<size_t>(count, 1)));
+}
+
+size_t EpochHashTable::BucketCount() const {
+    return this->buckets.load(memory_order_acquire)->mask + 1;
+}
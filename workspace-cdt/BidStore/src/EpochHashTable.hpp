@@ -0,0 +1,135 @@
+//============================================================================
+// Name        : EpochHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Chained hash table for bids with lock-free lookups
+//============================================================================
+
+#ifndef EPOCHHASHTABLE_HPP_
+#define EPOCHHASHTABLE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "Bid.hpp"
+#include "EpochReclamation.hpp"
+#include "HashFunctions.hpp"
+
+//============================================================================
+// Epoch Hash Table class definition
+//============================================================================
+
+/**
+ * A chained hash table of bids for read-mostly sharing between threads.
+ *
+ * Lookups take no lock and write nothing shared: they enter an epoch (see
+ * EpochReclamation.hpp) and follow the chains with acquire loads. Writers
+ * never change a node a reader may be looking at. They build a new node
+ * and publish it with a single release store, RCU style; replacing a bid
+ * swaps in a new node, and unlinked nodes are retired to the epoch domain
+ * rather than deleted.
+ *
+ * Writers to the same bucket serialize on one of a fixed set of
+ * cache-line aligned locks (the bucket index modulo the lock count, so a
+ * bucket always maps to the same lock). Growing the bucket array takes
+ * every lock, copies the chains into a new array and publishes it;
+ * readers still in the old array finish there, and it is retired with its
+ * nodes.
+ */
+class EpochHashTable {
+
+private:
+    struct BidNode {
+        Bid bid;
+        uint64_t hash;
+        std::atomic<BidNode*> next;
+
+        BidNode(Bid&& bid, uint64_t hash, BidNode* next)
+            : bid(std::move(bid)), hash(hash), next(next) {
+        }
+    };
+
+    // a bucket array owns the chains linked from it
+    struct Buckets {
+        size_t mask;
+        std::unique_ptr<std::atomic<BidNode*>[]> heads;
+
+        explicit Buckets(size_t count);
+        ~Buckets();
+    };
+
+    struct alignas(64) WriteLock {
+        std::mutex lock;
+        std::atomic<size_t> count{ 0 };	// bids in the buckets of this lock
+    };
+
+    std::atomic<Buckets*> buckets;
+    std::unique_ptr<WriteLock[]> locks;
+    size_t lockMask;
+
+    const BidNode* findNode(std::string_view bidId, uint64_t hash) const;
+    WriteLock& lockFor(uint64_t hash);
+    void grow(size_t bucketCount);
+
+public:
+    explicit EpochHashTable(size_t lockCount = 1024);
+    virtual ~EpochHashTable();
+    EpochHashTable(const EpochHashTable&) = delete;
+    EpochHashTable& operator=(const EpochHashTable&) = delete;
+    bool Insert(const Bid& bid);
+    bool Insert(Bid&& bid);
+    bool Remove(const std::string& bidId);
+    const Bid* Find(std::string_view bidId) const;
+    bool Find(std::string_view bidId, Bid& bid) const;
+    Bid Search(const std::string& bidId) const;
+    template<typename Visitor>
+    bool Visit(std::string_view bidId, Visitor visit) const;
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void PrintAll() const;
+    size_t Size() const;
+    void Reserve(size_t count);
+    size_t BucketCount() const;
+};
+
+/**
+ * Call visit(const Bid&) on the bid with an id, without copying it or
+ * taking a lock. The visitor may call back into the table.
+ *
+ * @return false if the id is not in the table
+ */
+template<typename Visitor>
+bool EpochHashTable::Visit(std::string_view bidId, Visitor visit) const {
+    EpochGuard guard;
+    const BidNode* node = this->findNode(bidId, hashBidId(bidId));
+    if (node == nullptr) {
+        return false;
+    }
+    visit(node->bid);
+    return true;
+}
+
+/**
+ * Call visit(const Bid&) for every bid. The walk runs concurrently with
+ * writers: each bid present throughout is visited once, bids inserted or
+ * removed meanwhile may or may not be.
+ */
+template<typename Visitor>
+void EpochHashTable::ForEach(Visitor visit) const {
+    EpochGuard guard;
+    const Buckets* current = this->buckets.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= current->mask; ++i) {
+        for (const BidNode* node = current->heads[i].load(std::memory_order_acquire);
+                node != nullptr; node = node->next.load(std::memory_order_acquire)) {
+            visit(node->bid);
+        }
+    }
+}
+
+#endif /* EPOCHHASHTABLE_HPP_ */
@@ -0,0 +1,183 @@
+//============================================================================
+// Name        : EpochReclamation.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Epoch-based reclamation for structures with lock-free readers
+//============================================================================
+
+#include <thread>
+
+#include "EpochReclamation.hpp"
+
+using namespace std;
+
+/**
+ * The process-wide domain. It is never destroyed, so threads that exit
+ * during static destruction can still hand it their retired objects.
+ */
+EpochDomain& EpochDomain::Instance() {
+    static EpochDomain* domain = new EpochDomain();
+    return *domain;
+}
+
+EpochDomain::ThreadState& EpochDomain::threadState() {
+    thread_local ThreadState state;
+    return state;
+}
+
+/**
+ * A thread's objects outlive it until they are safe to free; its record
+ * goes back to the domain for the next new thread
+ */
+EpochDomain::ThreadState::~ThreadState() {
+    EpochDomain& domain = EpochDomain::Instance();
+    if (!this->retired.empty()) {
+        lock_guard<mutex> guard(domain.orphanLock);
+        domain.orphans.insert(domain.orphans.end(), this->retired.begin(),
+                this->retired.end());
+    }
+    if (this->record != nullptr) {
+        this->record->epoch.store(0, memory_order_release);
+        this->record->inUse.store(false, memory_order_release);
+    }
+}
+
+/**
+ * Claim a free record, or add one to the list. Records are never freed,
+ * so readers of the list need no protection.
+ */
+EpochDomain::Record* EpochDomain::acquireRecord() {
+    for (Record* record = this->records.load(memory_order_acquire); record != nullptr;
+            record = record->next) {
+        bool expected = false;
+        if (!record->inUse.load(memory_order_relaxed)
+                && record->inUse.compare_exchange_strong(expected, true)) {
+            return record;
+        }
+    }
+
+    Record* record = new Record();
+    record->inUse.store(true, memory_order_relaxed);
+    record->next = this->records.load(memory_order_relaxed);
+    while (!this->records.compare_exchange_weak(record->next, record,
+            memory_order_release, memory_order_relaxed)) {
+    }
+    return record;
+}
+
+/**
+ * Enter a read-side critical section (see EpochGuard)
+ */
+void EpochDomain::Enter() {
+    ThreadState& state = threadState();
+    if (state.depth++ > 0) {
+        return;
+    }
+    if (state.record == nullptr) {
+        state.record = this->acquireRecord();
+    }
+    state.record->epoch.store(this->globalEpoch.load(memory_order_relaxed),
+            memory_order_relaxed);
+    // the announcement must be visible before any pointer is read; pairs
+    // with the fence in tryAdvance()
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/**
+ * Leave a read-side critical section
+ */
+void EpochDomain::Leave() {
+    ThreadState& state = threadState();
+    if (--state.depth == 0) {
+        state.record->epoch.store(0, memory_order_release);
+    }
+}
+
+/**
+ * Free an object once no reader can hold it. The object must already be
+ * unreachable for new readers.
+ *
+ * @param object The unlinked object
+ * @param destroy Frees it, e.g. by delete through its real type
+ */
+void EpochDomain::Retire(void* object, void (*destroy)(void*)) {
+    ThreadState& state = threadState();
+    state.retired.push_back({ object, destroy, this->globalEpoch.load() });
+    if (state.retired.size() >= COLLECT_THRESHOLD) {
+        this->Collect();
+    }
+}
+
+/**
+ * Advance the global epoch if every reader inside a guard has seen the
+ * current one
+ *
+ * @return true if the epoch moved on
+ */
+bool EpochDomain::tryAdvance() {
+    uint64_t epoch = this->globalEpoch.load();
+    atomic_thread_fence(memory_order_seq_cst);
+    for (Record* record = this->records.load(memory_order_acquire); record != nullptr;
+            record = record->next) {
+        uint64_t announced = record->epoch.load(memory_order_acquire);
+        if (announced != 0 && announced != epoch) {
+            return false;
+        }
+    }
+    return this->globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+/**
+ * Free every object in a list retired before the given epoch
+ */
+void EpochDomain::freeRetired(vector<Retired>& retired, uint64_t safeBefore) {
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); ++i) {
+        if (retired[i].epoch < safeBefore) {
+            retired[i].destroy(retired[i].object);
+        } else {
+            retired[kept++] = retired[i];
+        }
+    }
+    retired.resize(kept);
+}
+
+/**
+ * Try to advance the epoch, then free what this thread (and any exited
+ * thread) retired two or more epochs ago
+ */
+void EpochDomain::Collect() {
+    this->tryAdvance();
+    uint64_t safeBefore = this->globalEpoch.load() - 1;
+    this->freeRetired(threadState().retired, safeBefore);
+
+    unique_lock<mutex> guard(this->orphanLock, try_to_lock);
+    if (guard.owns_lock() && !this->orphans.empty()) {
+        this->freeRetired(this->orphans, safeBefore);
+    }
+}
+
+/**
+ * Wait until everything this thread and exited threads have retired has
+ * been freed. Must not be called inside an EpochGuard, which would keep
+ * the epoch from advancing.
+ */
+void EpochDomain::Synchronize() {
+    while (true) {
+        this->Collect();
+        bool empty = threadState().retired.empty();
+        {
+            lock_guard<mutex> guard(this->orphanLock);
+            empty = empty && this->orphans.empty();
+        }
+        if (empty) {
+            return;
+        }
+        this_thread::yield();
+    }
+}
+
+uint64_t EpochDomain::Epoch() const {
+    return this->globalEpoch.load(memory_order_relaxed);
+}
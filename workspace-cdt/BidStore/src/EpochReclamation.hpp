@@ -0,0 +1,115 @@
+//============================================================================
+// Name        : EpochReclamation.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Epoch-based reclamation for structures with lock-free readers
+//============================================================================
+
+#ifndef EPOCHRECLAMATION_HPP_
+#define EPOCHRECLAMATION_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+//============================================================================
+// Epoch-based reclamation
+//
+// Readers of a lock-free structure hold an EpochGuard while they follow
+// its pointers. A writer that unlinks an object hands it to retire()
+// instead of deleting it; the object is freed once every thread that
+// could still be looking at it has left its guard.
+//
+// The domain keeps a global epoch. Entering a guard copies the epoch into
+// the thread's own record (a store to a cache line no other thread
+// writes, so readers never contend). An object retired in epoch e is safe
+// to free once the global epoch reaches e + 2: the epoch only advances
+// when every active reader has announced the current one, so two advances
+// mean every reader from epoch e has left.
+//============================================================================
+
+class EpochDomain {
+
+private:
+    // one per thread that has used the domain, reused after the thread exits
+    struct alignas(64) Record {
+        std::atomic<uint64_t> epoch{ 0 };	// announced epoch, 0 when outside a guard
+        std::atomic<bool> inUse{ false };
+        Record* next = nullptr;
+    };
+
+    struct Retired {
+        void* object;
+        void (*destroy)(void*);
+        uint64_t epoch;
+    };
+
+    // a thread's nesting depth and retired objects
+    struct ThreadState {
+        Record* record = nullptr;
+        unsigned int depth = 0;
+        std::vector<Retired> retired;
+        ~ThreadState();
+    };
+
+    alignas(64) std::atomic<uint64_t> globalEpoch{ 1 };
+    alignas(64) std::atomic<Record*> records{ nullptr };
+    std::mutex orphanLock;
+    std::vector<Retired> orphans;		// left behind by exited threads
+
+    static ThreadState& threadState();
+    Record* acquireRecord();
+    bool tryAdvance();
+    void freeRetired(std::vector<Retired>& retired, uint64_t safeBefore);
+
+    EpochDomain() = default;
+
+public:
+    // objects a thread retires before it tries to advance the epoch
+    static constexpr size_t COLLECT_THRESHOLD = 128;
+
+    static EpochDomain& Instance();
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    void Enter();
+    void Leave();
+    void Retire(void* object, void (*destroy)(void*));
+    void Collect();
+    void Synchronize();
+    uint64_t Epoch() const;
+};
+
+/**
+ * Hand an unlinked object to the domain to delete once no reader can
+ * still hold it
+ */
+template<typename T>
+void retire(T* object) {
+    EpochDomain::Instance().Retire(object, [](void* pointer) {
+        delete static_cast<T*>(pointer);
+    });
+}
+
+/**
+ * Keeps the current thread inside an epoch for its lifetime, so objects
+ * it reaches through a lock-free structure are not freed under it.
+ * Guards nest; only the outermost one announces.
+ */
+class EpochGuard {
+
+public:
+    EpochGuard() {
+        EpochDomain::Instance().Enter();
+    }
+    ~EpochGuard() {
+        EpochDomain::Instance().Leave();
+    }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+#endif /* EPOCHRECLAMATION_HPP_ */
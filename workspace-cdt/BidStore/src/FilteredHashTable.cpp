@@ -0,0 +1,139 @@
+//============================================================================
+// Name        : FilteredHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table for bids behind a Bloom filter of their ids
+//============================================================================
+
+#include <algorithm>
+
+#include "FilteredHashTable.hpp"
+
+using namespace std;
+
+namespace {
+
+const size_t MIN_FILTER_KEYS = 1024;
+
+}
+
+/**
+ * Default constructor
+ */
+FilteredHashTable::FilteredHashTable() : filter(MIN_FILTER_KEYS) {
+}
+
+/**
+ * Build the filter again from the bids in the table
+ *
+ * @param capacity Ids to size it for; at least half as many again as
+ *        the table holds
+ */
+void FilteredHashTable::rebuildFilter(size_t capacity) {
+    size_t bids = HashTable::Size();
+    capacity = max({ capacity, bids + bids / 2, MIN_FILTER_KEYS });
+    this->filter = BlockedBloomFilter(capacity);
+    HashTable::ForEach([this](const Bid& bid) {
+        this->filter.Add(hashBidId(bid.bidId));
+    });
+}
+
+/**
+ * Insert a bid, replacing any bid with the same id
+ *
+ * @return true if the id was new
+ */
+bool FilteredHashTable::Insert(const Bid& bid) {
+    return this->Insert(Bid(bid));
+}
+
+bool FilteredHashTable::Insert(Bid&& bid) {
+    uint64_t hash = hashBidId(bid.bidId);
+    if (!HashTable::Insert(std::move(bid))) {
+        return false;
+    }
+    this->filterInserted(hash);
+    return true;
+}
+
+/**
+ * Add the id hash of a newly inserted bid to the filter, rebuilding it
+ * instead once it holds as many adds as it was sized for
+ */
+void FilteredHashTable::filterInserted(uint64_t hash) {
+    if (this->filter.Count() >= this->filter.Capacity()) {
+        this->rebuildFilter();
+    } else {
+        this->filter.Add(hash);
+    }
+}
+
+/**
+ * Remove a bid. Its id stays in the filter until the next rebuild.
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool FilteredHashTable::Remove(string_view bidId) {
+    if (!this->filter.MayContain(hashBidId(bidId))) {
+        return false;
+    }
+    return HashTable::Remove(bidId);
+}
+
+void FilteredHashTable::Clear() {
+    HashTable::Clear();
+    this->filter.Clear();
+}
+
+/**
+ * Size the table and the filter for a number of bids up front
+ *
+ * @param count Number of bids expected
+ */
+void FilteredHashTable::Reserve(size_t count) {
+    HashTable::Reserve(count);
+    if (count > this->filter.Capacity()) {
+        this->rebuildFilter(count);
+    }
+}
+
+/**
+ * Shrink the table to its bids (HashTable::ShrinkToFit) and rebuild the
+ * filter for them, which also drops the ids removed since the last
+ * rebuild
+ */
+void FilteredHashTable::ShrinkToFit() {
+    HashTable::ShrinkToFit();
+    this->rebuildFilter();
+}
+
+/**
+ * Find the bid with an id without copying it. Most ids that are not in
+ * the table are turned away by the filter without touching it.
+ *
+ * @return pointer to the bid, nullptr if not found; valid until the next
+ *         Insert or Remove
+ */
+const Bid* FilteredHashTable::Find(string_view bidId) const {
+    if (!this->filter.MayContain(hashBidId(bidId))) {
+        return nullptr;
+    }
+    return HashTable::Find(bidId);
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid FilteredHashTable::Search(const string& bidId) const {
+    const Bid* bid = this->Find(bidId);
+    return bid != nullptr ? *bid : Bid();
+}
+
+const BlockedBloomFilter& FilteredHashTable::Filter() const {
+    return this->filter;
+}
@@ -0,0 +1,150 @@
+//============================================================================
+// Name        : FilteredHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table for bids behind a Bloom filter of their ids
+//============================================================================
+
+#ifndef FILTEREDHASHTABLE_HPP_
+#define FILTEREDHASHTABLE_HPP_
+
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Bid.hpp"
+#include "BloomFilter.hpp"
+#include "HashFunctions.hpp"
+#include "HashTable.hpp"
+
+//============================================================================
+// Filtered Hash Table class definition
+//============================================================================
+
+/**
+ * A HashTable of bids for workloads where most lookups miss, such as
+ * validating incoming references against the loaded bids.
+ *
+ * A blocked Bloom filter of the ids sits in front of the table: a lookup
+ * first tests the filter, one 32-byte block, and only the ids it lets
+ * through (every loaded id and about 0.5% of the others) go on to the
+ * table. The filter takes 12 to 18 bits per id where the table takes
+ * tens of bytes, so it stays in cache when the table does not.
+ *
+ * Insert adds to the filter. Remove leaves the id's bits set, since a
+ * Bloom filter cannot drop a key; that only lets a few more misses
+ * through. Once the filter holds as many adds as it was sized for, it is
+ * rebuilt from the table, which clears the removed ids, with room for
+ * half as many bids again.
+ *
+ * The table is inherited privately, as FundIndexedHashTable does, so no
+ * insert can bypass the filter.
+ */
+class FilteredHashTable : private HashTable {
+
+private:
+    BlockedBloomFilter filter;
+
+    void rebuildFilter(size_t capacity = 0);
+    void filterInserted(uint64_t hash);
+
+public:
+    using HashTable::ForEach;
+    using HashTable::PrintAll;
+    using HashTable::Export;
+    using HashTable::Size;
+    using HashTable::Capacity;
+    using HashTable::LoadFactor;
+    using HashTable::SetIncrementalGrowth;
+    using HashTable::Stats;
+
+    FilteredHashTable();
+    bool Insert(const Bid& bid);
+    bool Insert(Bid&& bid);
+    template<typename... Args>
+    bool Emplace(Args&&... args);
+    template<std::ranges::random_access_range Range>
+    void BulkLoad(Range&& bids, unsigned int threads = 0);
+    bool Remove(std::string_view bidId);
+    void Clear();
+    void Reserve(size_t count);
+    void ShrinkToFit();
+
+    const Bid* Find(std::string_view bidId) const;
+    Bid Search(const std::string& bidId) const;
+    template<std::ranges::random_access_range Keys>
+    size_t SearchMany(const Keys& keys, std::span<const Bid*> found) const;
+    const BlockedBloomFilter& Filter() const;
+};
+
+/**
+ * Construct a bid from its fields in the table (see HashMap::Emplace) and
+ * add its id to the filter
+ *
+ * @param args Arguments forwarded to the Bid constructor
+ */
+template<typename... Args>
+bool FilteredHashTable::Emplace(Args&&... args) {
+    if (!HashTable::Emplace(std::forward<Args>(args)...)) {
+        return false;
+    }
+    // a new bid is stored after all the others
+    this->filterInserted(hashBidId(this->At(this->Size() - 1).bidId));
+    return true;
+}
+
+/**
+ * Load a batch of bids with HashTable::BulkLoad, then build the filter in
+ * one pass
+ */
+template<std::ranges::random_access_range Range>
+void FilteredHashTable::BulkLoad(Range&& bids, unsigned int threads) {
+    try {
+        HashTable::BulkLoad(std::forward<Range>(bids), threads);
+    } catch (...) {
+        this->rebuildFilter();		// cover whatever did load
+        throw;
+    }
+    this->rebuildFilter();
+}
+
+/**
+ * Batched lookup: ids the filter rejects are answered at once, and only
+ * the rest go to HashTable::SearchMany
+ *
+ * @param keys Ids to look up
+ * @param found Receives, at the same position as each id, a pointer to
+ *        its bid or nullptr; valid until the next Insert or Remove
+ * @return the number of ids found
+ */
+template<std::ranges::random_access_range Keys>
+size_t FilteredHashTable::SearchMany(const Keys& keys, std::span<const Bid*> found) const {
+    size_t count = std::ranges::size(keys);
+    if (found.size() < count) {
+        throw std::invalid_argument("FilteredHashTable::SearchMany: output shorter than input");
+    }
+    std::vector<std::string_view> passed;
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < count; ++i) {
+        std::string_view bidId = keys[i];
+        found[i] = nullptr;
+        if (this->filter.MayContain(hashBidId(bidId))) {
+            passed.push_back(bidId);
+            positions.push_back(i);
+        }
+    }
+    std::vector<const Bid*> bids(passed.size());
+    size_t hits = HashTable::SearchMany(passed, bids);
+    for (size_t k = 0; k < positions.size(); ++k) {
+        found[positions[k]] = bids[k];
+    }
+    return hits;
+}
+
+#endif /* FILTEREDHASHTABLE_HPP_ */
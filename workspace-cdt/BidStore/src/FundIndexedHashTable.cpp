@@ -0,0 +1,175 @@
+//============================================================================
+// Name        : FundIndexedHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table for bids with a secondary index on fund
+//============================================================================
+
+#include <algorithm>
+
+#include "FundIndexedHashTable.hpp"
+
+using namespace std;
+
+/**
+ * Make room for one more bid in a fund's list, creating the list if
+ * needed. Strong guarantee: if it throws, the index is unchanged.
+ */
+void FundIndexedHashTable::reserveFundSlot(const string& fund) {
+    vector<uint32_t>& members = this->fundIndex[fund];
+    if (members.size() < members.capacity()) {
+        return;
+    }
+    try {
+        members.reserve(max<size_t>(4, members.size() * 2));
+    } catch (...) {
+        if (members.empty()) {
+            this->fundIndex.Remove(fund);
+        }
+        throw;
+    }
+}
+
+/**
+ * Add the bid at a table position to its fund's list. Strong guarantee:
+ * if it throws, the index is unchanged.
+ */
+void FundIndexedHashTable::indexEntry(size_t index) {
+    const Bid& bid = HashTable::At(index);
+    if (this->fundPositions.size() <= index) {
+        this->fundPositions.resize(index + 1);
+    }
+    this->reserveFundSlot(bid.fund);
+    vector<uint32_t>& members = *this->fundIndex.Find(bid.fund);
+    this->fundPositions[index] = static_cast<uint32_t>(members.size());
+    members.push_back(static_cast<uint32_t>(index));		// within capacity
+}
+
+/**
+ * Drop the bid at a table position from its fund's list by moving the
+ * list's last member into its place, and drop the fund once it has no
+ * bids
+ */
+void FundIndexedHashTable::unindexEntry(size_t index) {
+    const string& fund = HashTable::At(index).fund;
+    vector<uint32_t>& members = *this->fundIndex.Find(fund);
+    uint32_t position = this->fundPositions[index];
+    uint32_t moved = members.back();
+    members[position] = moved;
+    this->fundPositions[moved] = position;
+    members.pop_back();
+    if (members.empty()) {
+        this->fundIndex.Remove(fund);
+    }
+}
+
+void FundIndexedHashTable::rebuildIndex() {
+    this->fundIndex.Clear();
+    this->fundPositions.assign(HashTable::Size(), 0);
+    for (size_t index = 0; index < HashTable::Size(); ++index) {
+        this->indexEntry(index);
+    }
+}
+
+/**
+ * Insert a bid, replacing any bid with the same id (and moving it to the
+ * new bid's fund if that changed). If the insert throws, the table and
+ * the index are left as they were.
+ *
+ * @return true if the id was new
+ */
+bool FundIndexedHashTable::Insert(const Bid& bid) {
+    return this->Insert(Bid(bid));
+}
+
+bool FundIndexedHashTable::Insert(Bid&& bid) {
+    size_t index = HashTable::IndexOf(bid.bidId);
+    if (index != NO_INDEX) {
+        if (HashTable::At(index).fund == bid.fund) {
+            return HashTable::Insert(std::move(bid));	// same position and fund
+        }
+        // room in the new fund first; from there on nothing can throw
+        this->reserveFundSlot(bid.fund);
+        this->unindexEntry(index);
+        HashTable::Insert(std::move(bid));
+        this->indexEntry(index);
+        return false;
+    }
+
+    HashTable::Insert(std::move(bid));
+    index = HashTable::Size() - 1;		// a new bid is always the last entry
+    try {
+        this->indexEntry(index);
+    } catch (...) {
+        HashTable::Remove(string_view(HashTable::At(index).bidId));
+        this->fundPositions.resize(HashTable::Size());
+        throw;
+    }
+    return true;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool FundIndexedHashTable::Remove(string_view bidId) {
+    size_t index = HashTable::IndexOf(bidId);
+    if (index == NO_INDEX) {
+        return false;
+    }
+    this->unindexEntry(index);
+    size_t last = HashTable::Size() - 1;
+    HashTable::Remove(bidId);
+
+    // the table moved its last bid into the hole: repoint its reference
+    if (index != last) {
+        uint32_t position = this->fundPositions[last];
+        (*this->fundIndex.Find(HashTable::At(index).fund))[position] = static_cast<uint32_t>(index);
+        this->fundPositions[index] = position;
+    }
+    this->fundPositions.pop_back();
+    return true;
+}
+
+void FundIndexedHashTable::Clear() {
+    HashTable::Clear();
+    this->fundIndex.Clear();
+    this->fundPositions.clear();
+}
+
+/**
+ * Find every bid of a fund without copying them
+ *
+ * @param fund The fund to search for
+ * @return pointers to the fund's bids, in no particular order, valid
+ *         until the next Insert or Remove; empty if the fund has none
+ */
+vector<const Bid*> FundIndexedHashTable::SearchByFund(string_view fund) const {
+    vector<const Bid*> bids;
+    const vector<uint32_t>* members = this->fundIndex.Find(fund);
+    if (members != nullptr) {
+        bids.reserve(members->size());
+        for (uint32_t index : *members) {
+            bids.push_back(&HashTable::At(index));
+        }
+    }
+    return bids;
+}
+
+/**
+ * @return the number of bids in a fund
+ */
+size_t FundIndexedHashTable::FundSize(string_view fund) const {
+    const vector<uint32_t>* members = this->fundIndex.Find(fund);
+    return members != nullptr ? members->size() : 0;
+}
+
+/**
+ * @return the number of funds with at least one bid
+ */
+size_t FundIndexedHashTable::FundCount() const {
+    return this->fundIndex.Size();
+}
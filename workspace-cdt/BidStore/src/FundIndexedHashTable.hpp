@@ -0,0 +1,111 @@
+//============================================================================
+// Name        : FundIndexedHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table for bids with a secondary index on fund
+//============================================================================
+
+#ifndef FUNDINDEXEDHASHTABLE_HPP_
+#define FUNDINDEXEDHASHTABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Bid.hpp"
+#include "HashFunctions.hpp"
+#include "HashMap.hpp"
+#include "HashTable.hpp"
+
+//============================================================================
+// Fund Indexed Hash Table class definition
+//============================================================================
+
+/**
+ * A HashTable of bids that also indexes them by fund, so the bids of one
+ * fund are found in time proportional to their number rather than by
+ * scanning the whole table.
+ *
+ * The index maps each fund to the table positions of its bids (4 bytes
+ * each; see HashMap::IndexOf), and keeps, per table position, where in
+ * its fund's list the bid is. Insert and Remove keep both current in
+ * constant time: removing a bid swaps the last entry of its fund's list
+ * into its place, and when the table moves its last bid into the hole,
+ * only that bid's one reference is repointed.
+ *
+ * The table is inherited privately: every way of changing it goes
+ * through this class, so the index cannot be bypassed.
+ */
+class FundIndexedHashTable : private HashTable {
+
+private:
+    // fund -> table positions of its bids
+    HashMap<std::string, std::vector<uint32_t>, StringHash> fundIndex;
+    // table position -> position in its fund's list
+    std::vector<uint32_t> fundPositions;
+
+    void reserveFundSlot(const std::string& fund);
+    void indexEntry(size_t index);
+    void unindexEntry(size_t index);
+    void rebuildIndex();
+
+public:
+    using HashTable::Find;
+    using HashTable::Search;
+    using HashTable::SearchMany;
+    using HashTable::ForEach;
+    using HashTable::PrintAll;
+    using HashTable::Export;
+    using HashTable::Size;
+    using HashTable::Reserve;
+    using HashTable::ShrinkToFit;
+    using HashTable::Capacity;
+    using HashTable::LoadFactor;
+    using HashTable::SetIncrementalGrowth;
+    using HashTable::Stats;
+
+    bool Insert(const Bid& bid);
+    bool Insert(Bid&& bid);
+    template<typename... Args>
+    bool Emplace(Args&&... args);
+    template<std::ranges::random_access_range Range>
+    void BulkLoad(Range&& bids, unsigned int threads = 0);
+    bool Remove(std::string_view bidId);
+    void Clear();
+
+    std::vector<const Bid*> SearchByFund(std::string_view fund) const;
+    size_t FundSize(std::string_view fund) const;
+    size_t FundCount() const;
+};
+
+/**
+ * Build a bid from its fields and insert it by move
+ *
+ * @param args Arguments forwarded to the Bid constructor
+ */
+template<typename... Args>
+bool FundIndexedHashTable::Emplace(Args&&... args) {
+    return this->Insert(Bid(std::forward<Args>(args)...));
+}
+
+/**
+ * Load a batch of bids with HashTable::BulkLoad, then index them in one
+ * pass rather than one at a time
+ */
+template<std::ranges::random_access_range Range>
+void FundIndexedHashTable::BulkLoad(Range&& bids, unsigned int threads) {
+    try {
+        HashTable::BulkLoad(std::forward<Range>(bids), threads);
+    } catch (...) {
+        this->rebuildIndex();		// keep the index in step with what loaded
+        throw;
+    }
+    this->rebuildIndex();
+}
+
+#endif /* FUNDINDEXEDHASHTABLE_HPP_ */
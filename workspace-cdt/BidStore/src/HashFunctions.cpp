@@ -0,0 +1,215 @@
+//============================================================================
+// Name        : HashFunctions.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash functions for bid ids and a bucket distribution report
+//============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+
+#include "HashFunctions.hpp"
+
+using namespace std;
+
+//============================================================================
+// Bid id hash functions
+//============================================================================
+
+/**
+ * Hash any bid id as a byte string
+ */
+uint64_t hashString(string_view bidId) {
+    return hashBytes(bidId.data(), bidId.size());
+}
+
+/**
+ * Default bid id hash. eBid ids are decimal numbers, which are cheaper to
+ * parse and mix as integers than to hash byte by byte; anything else
+ * (letters, signs, over 19 digits) is hashed as a string.
+ */
+uint64_t hashBidId(string_view bidId) {
+    if (bidId.empty() || bidId.size() > 19) {
+        return hashString(bidId);
+    }
+    uint64_t value = 0;
+    for (char c : bidId) {
+        unsigned int digit = static_cast<unsigned char>(c) - '0';
+        if (digit > 9) {
+            return hashString(bidId);
+        }
+        value = value * 10 + digit;
+    }
+    // numbers with leading zeros share a hash with the plain number; the
+    // table compares the ids themselves, so that only costs a probe
+    return mixInteger(value);
+}
+
+/**
+ * std::hash of the id, with a finalizer so every bit is usable (the
+ * previous HashTable hash)
+ */
+uint64_t hashStdString(string_view bidId) {
+    uint64_t key = std::hash<string_view>()(bidId);
+    key = (key ^ (key >> 33)) * 0xFF51AFD7ED558CCDull;
+    key = (key ^ (key >> 33)) * 0xC4CEB9FE1A85EC53ull;
+    return key ^ (key >> 33);
+}
+
+/**
+ * The original chained table's key: atoi of the id, unmixed. Kept for
+ * the distribution report, where it shows why it was replaced.
+ */
+uint64_t hashAtoi(string_view bidId) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < bidId.size() && (bidId[i] == '-' || bidId[i] == '+')) {
+        negative = bidId[i] == '-';
+        ++i;
+    }
+    uint32_t value = 0;
+    for (; i < bidId.size() && bidId[i] >= '0' && bidId[i] <= '9'; ++i) {
+        value = value * 10 + (bidId[i] - '0');
+    }
+    return negative ? static_cast<uint32_t>(0u - value) : value;
+}
+
+/**
+ * Look a hash function up by name: bidid, string, std or atoi
+ *
+ * @return false if the name is unknown
+ */
+bool findHashFunction(const string& name, BidHashFunction& function) {
+    if (name == "bidid") {
+        function = hashBidId;
+    } else if (name == "string") {
+        function = hashString;
+    } else if (name == "std") {
+        function = hashStdString;
+    } else if (name == "atoi") {
+        function = hashAtoi;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//============================================================================
+// Distribution report
+//============================================================================
+
+/**
+ * Measure how keys spread over a number of buckets (hash modulo buckets,
+ * which is the slot mask for power-of-two sizes), and, when the keys fit,
+ * the probe lengths of a Robin Hood table of that size
+ *
+ * @param keys Ids to hash, e.g. every id of an eBid file
+ * @param function Hash function under test
+ * @param buckets Bucket or slot count
+ */
+HashReport analyzeHash(const vector<string>& keys, BidHashFunction function,
+        size_t buckets) {
+    HashReport report;
+    report.keys = keys.size();
+    report.buckets = max<size_t>(buckets, 1);
+
+    vector<uint64_t> hashes;
+    hashes.reserve(keys.size());
+    for (const string& key : keys) {
+        hashes.push_back(function(key));
+    }
+
+    // bucket occupancy against the Poisson expectation
+    vector<uint32_t> counts(report.buckets, 0);
+    for (uint64_t hash : hashes) {
+        ++counts[hash % report.buckets];
+    }
+    double load = static_cast<double>(report.keys) / report.buckets;
+    double chiSquared = 0.0;
+    for (uint32_t count : counts) {
+        report.emptyBuckets += count == 0;
+        report.longestBucket = max<size_t>(report.longestBucket, count);
+        chiSquared += (count - load) * (count - load);
+    }
+    report.expectedEmptyBuckets = report.buckets * exp(-load);
+    report.collisions = report.keys - (report.buckets - report.emptyBuckets);
+    report.expectedCollisions = report.keys
+            - report.buckets * (1.0 - exp(-load));
+    if (load > 0.0 && report.buckets > 1) {
+        report.chiSquared = chiSquared / load / (report.buckets - 1);
+    }
+
+    // Robin Hood placement, as HashTable does it. A badly clustered hash
+    // makes this quadratic, so give up past a step budget.
+    if (report.keys < report.buckets) {
+        vector<int32_t> distance(report.buckets, -1);
+        vector<uint64_t> home(report.buckets, 0);
+        uint64_t steps = 0, budget = 64 * static_cast<uint64_t>(report.buckets);
+        uint64_t totalProbe = 0;
+        report.probed = true;
+        for (uint64_t hash : hashes) {
+            if (steps > budget) {
+                report.probed = false;
+                break;
+            }
+            uint64_t incomingHome = hash % report.buckets;
+            int32_t incoming = 0;
+            size_t position = incomingHome;
+            while (distance[position] >= 0) {
+                if (distance[position] < incoming) {
+                    swap(distance[position], incoming);
+                    swap(home[position], incomingHome);
+                }
+                ++incoming;
+                ++steps;
+                position = (position + 1) % report.buckets;
+            }
+            distance[position] = incoming;
+            home[position] = incomingHome;
+        }
+        for (int32_t probe : distance) {
+            if (probe >= 0) {
+                totalProbe += probe;
+                report.longestProbe = max<size_t>(report.longestProbe, probe);
+            }
+        }
+        report.meanProbe = static_cast<double>(totalProbe) / max<size_t>(report.keys, 1);
+    }
+
+    sort(hashes.begin(), hashes.end());
+    report.distinctHashes = unique(hashes.begin(), hashes.end()) - hashes.begin();
+
+    return report;
+}
+
+void printHashReportHeader(ostream& out) {
+    out << left << setw(8) << "hash" << right << setw(10) << "keys"
+            << setw(10) << "buckets" << setw(10) << "distinct" << setw(10)
+            << "empty" << setw(10) << "expected" << setw(11) << "collisions"
+            << setw(10) << "expected" << setw(9) << "longest" << setw(8)
+            << "chi2" << setw(8) << "probe" << setw(7) << "max" << endl;
+}
+
+/**
+ * Print one report as a table row; probe columns show "-" when the keys
+ * did not fit the buckets or clustered too badly to place
+ */
+void printHashReport(ostream& out, const string& name, const HashReport& report) {
+    out << left << setw(8) << name << right << setw(10) << report.keys
+            << setw(10) << report.buckets << setw(10) << report.distinctHashes
+            << setw(10) << report.emptyBuckets << fixed << setprecision(0)
+            << setw(10) << report.expectedEmptyBuckets << setw(11)
+            << report.collisions << setw(10) << report.expectedCollisions
+            << setw(9) << report.longestBucket << setprecision(2) << setw(8)
+            << report.chiSquared;
+    if (report.probed) {
+        out << setw(8) << report.meanProbe << setw(7) << report.longestProbe;
+    } else {
+        out << setw(8) << "-" << setw(7) << "-";
+    }
+    out << endl;
+    out.unsetf(ios::floatfield);
+}
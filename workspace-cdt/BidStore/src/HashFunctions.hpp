@@ -0,0 +1,242 @@
+//============================================================================
+// Name        : HashFunctions.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash functions for bid ids and a bucket distribution report
+//============================================================================
+
+#ifndef HASHFUNCTIONS_HPP_
+#define HASHFUNCTIONS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// signature shared by every bid id hash, so tables can be handed any of them
+typedef uint64_t (*BidHashFunction)(std::string_view bidId);
+
+//============================================================================
+// Building blocks
+//============================================================================
+
+/**
+ * 64 x 64 -> 128-bit multiply in place: a receives the low half, b the
+ * high half
+ */
+inline void multiply128(uint64_t& a, uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t aHigh = a >> 32, aLow = static_cast<uint32_t>(a);
+    uint64_t bHigh = b >> 32, bLow = static_cast<uint32_t>(b);
+    uint64_t high = aHigh * bHigh, middle1 = aHigh * bLow;
+    uint64_t middle2 = aLow * bHigh, low = aLow * bLow;
+    uint64_t carry = ((low >> 32) + static_cast<uint32_t>(middle1)
+            + static_cast<uint32_t>(middle2)) >> 32;
+    a = low + (middle1 << 32) + (middle2 << 32);
+    b = high + (middle1 >> 32) + (middle2 >> 32) + carry;
+#endif
+}
+
+/**
+ * The 128-bit product folded back to 64 bits by xor. One of these mixes
+ * every input bit into every output bit.
+ */
+inline uint64_t mum(uint64_t a, uint64_t b) {
+    multiply128(a, b);
+    return a ^ b;
+}
+
+/**
+ * Mix an integer key (e.g. a numeric bid id) into a hash with uniformly
+ * distributed bits, so sequential ids do not cluster in a power-of-two
+ * table
+ */
+inline uint64_t mixInteger(uint64_t key) {
+    return mum(key ^ 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull);
+}
+
+/**
+ * Hash a byte string, following the wyhash construction: input is read
+ * 8 or 16 bytes at a time and folded in with mum(), three lanes in
+ * parallel for long inputs
+ *
+ * @param data Bytes to hash
+ * @param length Number of bytes
+ * @param seed Optional seed, e.g. to vary the hash between tables
+ */
+inline uint64_t hashBytes(const void* data, size_t length, uint64_t seed = 0) {
+    const uint64_t secret[4] = { 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull,
+            0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull };
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    auto read64 = [](const unsigned char* at) {
+        uint64_t value;
+        std::memcpy(&value, at, 8);
+        return value;
+    };
+    auto read32 = [](const unsigned char* at) {
+        uint32_t value;
+        std::memcpy(&value, at, 4);
+        return static_cast<uint64_t>(value);
+    };
+
+    seed ^= mum(seed ^ secret[0], secret[1]);
+    uint64_t a, b;
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t shift = (length >> 3) << 2;
+            a = (read32(bytes) << 32) | read32(bytes + shift);
+            b = (read32(bytes + length - 4) << 32) | read32(bytes + length - 4 - shift);
+        } else if (length > 0) {
+            a = (static_cast<uint64_t>(bytes[0]) << 16)
+                    | (static_cast<uint64_t>(bytes[length >> 1]) << 8)
+                    | bytes[length - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t remaining = length;
+        if (remaining > 48) {
+            uint64_t lane1 = seed, lane2 = seed;
+            do {
+                seed = mum(read64(bytes) ^ secret[1], read64(bytes + 8) ^ seed);
+                lane1 = mum(read64(bytes + 16) ^ secret[2], read64(bytes + 24) ^ lane1);
+                lane2 = mum(read64(bytes + 32) ^ secret[3], read64(bytes + 40) ^ lane2);
+                bytes += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (remaining > 16) {
+            seed = mum(read64(bytes) ^ secret[1], read64(bytes + 8) ^ seed);
+            bytes += 16;
+            remaining -= 16;
+        }
+        a = read64(bytes + remaining - 16);
+        b = read64(bytes + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    multiply128(a, b);
+    return mum(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+//============================================================================
+// Bid id hash functions
+//============================================================================
+
+uint64_t hashString(std::string_view bidId);
+uint64_t hashBidId(std::string_view bidId);
+uint64_t hashStdString(std::string_view bidId);
+uint64_t hashAtoi(std::string_view bidId);
+
+bool findHashFunction(const std::string& name, BidHashFunction& function);
+
+//============================================================================
+// Hash policies for HashMap
+//============================================================================
+
+/**
+ * hashBidId as a HashMap policy. Transparent, so a table keyed by
+ * std::string can be searched by std::string_view or a C string.
+ */
+struct BidIdHash {
+    using is_transparent = void;
+
+    uint64_t operator()(std::string_view bidId) const {
+        return hashBidId(bidId);
+    }
+};
+
+/**
+ * hashString as a HashMap policy, for string keys that are not numeric
+ * (e.g. fund names)
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    uint64_t operator()(std::string_view key) const {
+        return hashString(key);
+    }
+};
+
+/**
+ * A hash function chosen at run time (e.g. by findHashFunction), for
+ * comparing hashes on the same table. Each lookup pays an indirect call.
+ */
+struct FunctionHash {
+    using is_transparent = void;
+
+    BidHashFunction function = hashBidId;
+
+    uint64_t operator()(std::string_view key) const {
+        return this->function(key);
+    }
+};
+
+/**
+ * Hash policy used when a HashMap is given none: integers are mixed,
+ * strings hashed with hashBytes, and anything else goes through std::hash
+ * with a mix on top, since many std::hash implementations are the
+ * identity
+ */
+template<typename Key>
+struct DefaultHash {
+    uint64_t operator()(const Key& key) const {
+        if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key>) {
+            return mixInteger(static_cast<uint64_t>(key));
+        } else {
+            return mixInteger(std::hash<Key>()(key));
+        }
+    }
+};
+
+template<>
+struct DefaultHash<std::string> : StringHash {
+};
+
+template<>
+struct DefaultHash<std::string_view> : StringHash {
+};
+
+//============================================================================
+// Distribution report
+//============================================================================
+
+/**
+ * How a set of keys spreads over the buckets of a table. Expected values
+ * are those of an ideal (uniformly random) hash at the same load.
+ */
+struct HashReport {
+    size_t keys = 0;
+    size_t buckets = 0;
+    size_t distinctHashes = 0;		// full 64-bit values, keys minus these collide outright
+    size_t emptyBuckets = 0;
+    double expectedEmptyBuckets = 0.0;
+    size_t collisions = 0;			// keys that share a bucket with an earlier key
+    double expectedCollisions = 0.0;
+    size_t longestBucket = 0;
+    double chiSquared = 0.0;		// per degree of freedom, about 1 when uniform
+    bool probed = false;			// keys fit and the placement finished
+    double meanProbe = 0.0;			// Robin Hood slots past home
+    size_t longestProbe = 0;
+};
+
+HashReport analyzeHash(const std::vector<std::string>& keys,
+        BidHashFunction function, size_t buckets);
+void printHashReportHeader(std::ostream& out);
+void printHashReport(std::ostream& out, const std::string& name,
+        const HashReport& report);
+
+#endif /* HASHFUNCTIONS_HPP_ */
@@ -0,0 +1,1582 @@
+//============================================================================
+// Name        : HashMap.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Generic open-addressing (Robin Hood) hash map
+//============================================================================
+
+#ifndef HASHMAP_HPP_
+#define HASHMAP_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <exception>
+#include <new>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "HashFunctions.hpp"
+#include "TableStats.hpp"
+
+//============================================================================
+// Allocation policy
+//============================================================================
+
+/**
+ * Default allocator for hash maps. Memory comes from calloc, which hands
+ * out large blocks as fresh zero pages, and default construction leaves
+ * it as it is, so allocating a slot array of millions of slots does not
+ * first write every one of them.
+ */
+template<typename T>
+struct HashAllocator {
+    using value_type = T;
+
+    HashAllocator() = default;
+    template<typename U>
+    HashAllocator(const HashAllocator<U>&) {
+    }
+
+    T* allocate(size_t count) {
+        void* memory = std::calloc(count, sizeof(T));
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+    void deallocate(T* memory, size_t) {
+        std::free(memory);
+    }
+    template<typename U, typename... Args>
+    void construct(U* place, Args&&... args) {
+        if constexpr (sizeof...(Args) == 0 && std::is_trivially_default_constructible_v<U>) {
+            ::new (static_cast<void*>(place)) U;		// already zero
+        } else {
+            ::new (static_cast<void*>(place)) U(std::forward<Args>(args)...);
+        }
+    }
+    template<typename U>
+    bool operator==(const HashAllocator<U>&) const {
+        return true;
+    }
+};
+
+//============================================================================
+// HashMap class definition
+//============================================================================
+
+/**
+ * Open-addressing hash map with Robin Hood probing, backward-shift
+ * removal and optional incremental growth.
+ *
+ * Entries are stored densely in fixed-size chunks; the slot array only
+ * holds 8-byte references to them, eight to a cache line. Each slot keeps
+ * the probe distance and 24 bits of the hash, so most mismatches are
+ * rejected without touching the entry. ForEach, and in the keyed form
+ * begin()/end(), walk the entries in that storage order, chunk by chunk,
+ * never touching the slot array.
+ *
+ * Removal leaves no tombstones: the following slots shift back and the
+ * last entry moves into the hole, so probe lengths after any amount of
+ * removing and inserting are those of a map freshly built with the same
+ * entries. A chunk left empty by removals is released once a second one
+ * is; the slot array never shrinks by itself (a map emptied and refilled
+ * would rehash twice), but ShrinkToFit rebuilds it at the smallest size
+ * the remaining entries fit.
+ *
+ * @tparam Key      Key type
+ * @tparam Value    Mapped type, or the stored type when KeyOf is given
+ * @tparam Hash     Callable returning a well-mixed 64-bit hash of a key.
+ *                  With Hash::is_transparent and KeyEqual::is_transparent,
+ *                  lookups accept any type the two can handle (e.g.
+ *                  std::string_view for std::string keys).
+ * @tparam KeyEqual Key comparison
+ * @tparam Allocator Allocation policy, rebound for entries and slots
+ * @tparam KeyOf    void for a map of Key to Value. Otherwise a callable
+ *                  extracting the key from a Value, which is then stored
+ *                  alone (e.g. a bid keyed by its own bidId).
+ */
+template<typename Key, typename Value, typename Hash = DefaultHash<Key>,
+        typename KeyEqual = std::equal_to<>,
+        typename Allocator = HashAllocator<Value>, typename KeyOf = void>
+class HashMap {
+
+public:
+    static constexpr bool keyed = !std::is_void_v<KeyOf>;
+
+    // a keyed entry holds its own key, so only read access is handed out
+    using Mapped = std::conditional_t<keyed, const Value, Value>;
+
+private:
+    struct Slot {
+        uint32_t meta;			// distance + 1 in the low byte (0 = empty), hash above
+        uint32_t index;			// position in the entries
+    };
+
+    struct MapEntry {
+        Key key;
+        Value value;
+        uint64_t hash;			// kept so growing never rehashes keys
+    };
+
+    struct KeyedEntry {
+        Value value;
+        uint64_t hash;
+
+        KeyedEntry(const Value& value, uint64_t hash)
+            : value(value), hash(hash) {
+        }
+
+        KeyedEntry(Value&& value, uint64_t hash)
+            : value(std::move(value)), hash(hash) {
+        }
+
+        // build the value from args; the hash is set once its key is known
+        template<typename... Args>
+        explicit KeyedEntry(std::in_place_t, Args&&... args)
+            : value(std::forward<Args>(args)...), hash(0) {
+        }
+    };
+
+    using Entry = std::conditional_t<keyed, KeyedEntry, MapEntry>;
+    using EntryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+    using EntryTraits = std::allocator_traits<EntryAllocator>;
+    using SlotArray = std::vector<Slot,
+            typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>>;
+
+    static constexpr size_t ENTRY_CHUNK = 1024;
+    static constexpr size_t INITIAL_CAPACITY = 256;
+    static constexpr uint32_t MAX_DISTANCE = 254;
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;	// also marks dead old slots
+    static constexpr size_t MIGRATE_STEP = 64;
+    static constexpr size_t BULK_PER_THREAD = 16384;	// fewer values per thread are loaded serially
+    static constexpr size_t PREFETCH_GROUP = 16;		// batched lookups in flight at once
+
+    template<typename K>
+    static constexpr bool transparent = requires {
+        typename Hash::is_transparent;
+        typename KeyEqual::is_transparent;
+    } && !std::is_same_v<K, Key>;
+
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual equal;
+    [[no_unique_address]] EntryAllocator entryAllocator;
+    [[no_unique_address]] mutable OperationCounters counters;	// empty unless BIDSTORE_STATS
+
+    // entries live in fixed-size chunks, so adding one never moves the rest
+    std::vector<Entry*> chunks;
+    size_t entryCount = 0;
+
+    SlotArray slots;
+    size_t mask = 0;			// slots.size() - 1, a power of two minus one
+    float maxLoadFactor = 0.875f;
+    size_t growAt = 0;			// entry count that triggers the next doubling
+
+    // incremental growth: the previous slot array stays readable (and
+    // otherwise frozen) until every slot below it has been migrated
+    bool incremental = false;
+    SlotArray oldSlots;
+    size_t oldMask = 0;
+    size_t migrated = 0;		// old slots below this have been moved
+
+    static uint32_t makeMeta(uint64_t hash, uint32_t distance) {
+        return static_cast<uint32_t>(hash >> 40) << 8 | (distance + 1);
+    }
+
+    static uint32_t distanceOf(uint32_t meta) {
+        return (meta & 0xFF) - 1;
+    }
+
+    // a hint only: compilers without the builtin simply do not prefetch
+    static void prefetch(const void* address) {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#else
+        (void) address;
+#endif
+    }
+
+    Entry& entry(size_t index) {
+        return this->chunks[index / ENTRY_CHUNK][index % ENTRY_CHUNK];
+    }
+
+    const Entry& entry(size_t index) const {
+        return this->chunks[index / ENTRY_CHUNK][index % ENTRY_CHUNK];
+    }
+
+    static const Key& keyOf(const Entry& stored) {
+        if constexpr (keyed) {
+            return KeyOf()(stored.value);
+        } else {
+            return stored.key;
+        }
+    }
+
+    template<typename K>
+    uint64_t hash(const K& key) const {
+        return static_cast<uint64_t>(this->hasher(key));
+    }
+
+    template<typename K>
+    size_t probe(const SlotArray& table, size_t tableMask, size_t skipBelow,
+            const K& key, uint64_t hash) const;
+    template<typename K>
+    uint32_t findIndex(const K& key, uint64_t hash) const;
+    uint32_t matchFingerprint(uint64_t hash) const;
+    bool place(uint64_t hash, uint32_t index);
+    void rebuild(size_t capacity, const uint8_t* unplaced = nullptr);
+    void grow();
+    void migrate(size_t count);
+    void repoint(uint32_t from, uint32_t to);
+    size_t capacityFor(size_t count) const;
+    Entry* nextEntry();
+    bool linkEntry(uint64_t hash);
+    template<typename... Args>
+    bool insertEntry(uint64_t hash, Args&&... args);
+    template<typename K>
+    bool removeKey(const K& key);
+    void destroyEntries();
+    void dropEntries(std::vector<uint32_t>& indices, bool repointSlots);
+    void placePartition(size_t end, const uint32_t* indices, size_t count,
+            std::vector<uint32_t>& overflow, std::vector<uint32_t>& duplicates);
+    template<typename Work>
+    static void runParallel(size_t threads, Work work);
+
+public:
+    static constexpr size_t NO_INDEX = SIZE_MAX;	// IndexOf of a missing key
+
+    /**
+     * Forward iterator over the stored values of a keyed map, in storage
+     * order, as ForEach visits them. Invalidated by Insert and Remove.
+     */
+    class ConstIterator {
+
+    private:
+        const HashMap* map = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value*;
+        using reference = const Value&;
+
+        ConstIterator() = default;
+        ConstIterator(const HashMap* map, size_t index) : map(map), index(index) {}
+
+        reference operator*() const { return this->map->entry(this->index).value; }
+        pointer operator->() const { return &**this; }
+        ConstIterator& operator++() { ++this->index; return *this; }
+        ConstIterator operator++(int) { ConstIterator old = *this; ++this->index; return old; }
+        bool operator==(const ConstIterator& other) const { return this->index == other.index; }
+    };
+
+    explicit HashMap(const Hash& hasher = Hash(), const KeyEqual& equal = KeyEqual(),
+            const Allocator& allocator = Allocator());
+    HashMap(HashMap&& other);
+    HashMap& operator=(HashMap&& other) noexcept;
+    void swap(HashMap& other) noexcept;
+    HashMap(const HashMap&) = delete;
+    HashMap& operator=(const HashMap&) = delete;
+    virtual ~HashMap();
+
+    // keyed form: the key comes from the value
+    bool Insert(const Value& value) requires keyed;
+    bool Insert(Value&& value) requires keyed;
+    template<typename... Args>
+    bool Emplace(Args&&... args) requires keyed;
+    template<std::ranges::random_access_range Range>
+    void BulkLoad(Range&& values, unsigned int threads = 0) requires keyed;
+
+    // map form
+    bool Insert(const Key& key, Value value) requires (!keyed);
+    Value& operator[](const Key& key) requires (!keyed);
+
+    Mapped* Find(const Key& key);
+    const Value* Find(const Key& key) const;
+    template<typename K>
+    Mapped* Find(const K& key) requires transparent<K>;
+    template<typename K>
+    const Value* Find(const K& key) const requires transparent<K>;
+    Value Search(const Key& key) const;
+    template<typename K>
+    size_t IndexOf(const K& key) const
+            requires std::is_same_v<K, Key> || transparent<K>;
+    const Value& At(size_t index) const;
+    template<std::ranges::random_access_range Keys>
+    size_t SearchMany(const Keys& keys, std::span<const Value*> found) const
+            requires std::is_same_v<std::ranges::range_value_t<Keys>, Key>
+                    || transparent<std::ranges::range_value_t<Keys>>;
+    bool Remove(const Key& key);
+    template<typename K>
+    bool Remove(const K& key) requires transparent<K>;
+
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    ConstIterator begin() const requires keyed;
+    ConstIterator end() const requires keyed;
+    void Clear();
+
+    size_t Size() const;
+    void Reserve(size_t count);
+    void ShrinkToFit();
+    size_t Capacity() const;
+    float LoadFactor() const;
+    float MaxLoadFactor() const;
+    void SetMaxLoadFactor(float loadFactor);
+    void SetIncrementalGrowth(bool enabled);
+    bool Growing() const;
+    TableStats Stats(size_t hotCount = 10) const;
+};
+
+//============================================================================
+// Construction
+//============================================================================
+
+/**
+ * Default constructor
+ *
+ * @param hasher Hash policy instance, for policies that carry state
+ * @param equal Key comparison instance
+ * @param allocator Allocator instance
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::HashMap(const Hash& hasher,
+        const KeyEqual& equal, const Allocator& allocator)
+        : hasher(hasher), equal(equal), entryAllocator(allocator),
+          slots(typename SlotArray::allocator_type(allocator)),
+          oldSlots(typename SlotArray::allocator_type(allocator)) {
+    this->rebuild(INITIAL_CAPACITY);
+}
+
+/**
+ * Move constructor; the other map is left empty
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::HashMap(HashMap&& other)
+        : HashMap(other.hasher, other.equal, other.entryAllocator) {
+    this->swap(other);
+}
+
+/**
+ * Move assignment; the other map takes this map's old contents
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>&
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::operator=(HashMap&& other) noexcept {
+    this->swap(other);
+    return *this;
+}
+
+/**
+ * Exchange the contents of two maps
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::swap(HashMap& other) noexcept {
+    using std::swap;
+    swap(this->hasher, other.hasher);
+    swap(this->equal, other.equal);
+    swap(this->entryAllocator, other.entryAllocator);
+    swap(this->chunks, other.chunks);
+    swap(this->entryCount, other.entryCount);
+    swap(this->slots, other.slots);
+    swap(this->mask, other.mask);
+    swap(this->maxLoadFactor, other.maxLoadFactor);
+    swap(this->growAt, other.growAt);
+    swap(this->incremental, other.incremental);
+    swap(this->oldSlots, other.oldSlots);
+    swap(this->oldMask, other.oldMask);
+    swap(this->migrated, other.migrated);
+    // the counters stay behind: they describe this object's own history
+}
+
+/**
+ * Destructor
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::~HashMap() {
+    this->destroyEntries();
+}
+
+/**
+ * Destroy every entry and release the chunks
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::destroyEntries() {
+    for (size_t i = 0; i < this->entryCount; ++i) {
+        EntryTraits::destroy(this->entryAllocator, &this->entry(i));
+    }
+    for (Entry* chunk : this->chunks) {
+        EntryTraits::deallocate(this->entryAllocator, chunk, ENTRY_CHUNK);
+    }
+    this->chunks.clear();
+    this->entryCount = 0;
+}
+
+//============================================================================
+// Probing and placement
+//============================================================================
+
+/**
+ * Locate the slot referring to a key in one slot array
+ *
+ * @param skipBelow Slots before this position are ignored (already
+ *        migrated out of the old array)
+ * @return the slot position, or table.size() if the key is not present
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename K>
+size_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::probe(const SlotArray& table,
+        size_t tableMask, size_t skipBelow, const K& key, uint64_t hash) const {
+    size_t position = hash & tableMask;
+    uint32_t wanted = makeMeta(hash, 0);		// fingerprint and distance together
+
+    uint32_t distance = 0;
+    for (; distance <= MAX_DISTANCE; ++distance) {
+        const Slot& slot = table[position];
+        // Robin Hood invariant: once we are further from home than the
+        // occupant (or hit an empty slot), the key cannot be further along
+        if ((slot.meta & 0xFF) < distance + 1) {
+            break;
+        }
+        if (slot.meta == wanted && position >= skipBelow && slot.index != NOT_FOUND
+                && this->equal(keyOf(this->entry(slot.index)), key)) {
+            this->counters.Probe(distance + 1);
+            return position;
+        }
+        ++wanted;
+        position = (position + 1) & tableMask;
+    }
+
+    this->counters.Probe(distance + 1);
+    return table.size();
+}
+
+/**
+ * Locate the entry of a key, looking in the old slot array as well while
+ * the map is growing
+ *
+ * @return the entry index, or NOT_FOUND
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename K>
+uint32_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::findIndex(const K& key,
+        uint64_t hash) const {
+    size_t position = this->probe(this->slots, this->mask, 0, key, hash);
+    if (position != this->slots.size()) {
+        this->counters.Lookup(true);
+        return this->slots[position].index;
+    }
+    if (!this->oldSlots.empty()) {
+        position = this->probe(this->oldSlots, this->oldMask, this->migrated, key, hash);
+        if (position != this->oldSlots.size()) {
+            this->counters.Lookup(true);
+            return this->oldSlots[position].index;
+        }
+    }
+    this->counters.Lookup(false);
+    return NOT_FOUND;
+}
+
+/**
+ * The entry of the first slot in a key's probe sequence whose fingerprint
+ * matches, without reading any entry. Usually that is the key's entry;
+ * the caller still compares keys.
+ *
+ * @return the entry index, or NOT_FOUND
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+uint32_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::matchFingerprint(uint64_t hash) const {
+    size_t position = hash & this->mask;
+    uint32_t wanted = makeMeta(hash, 0);
+
+    uint32_t distance = 0;
+    for (; distance <= MAX_DISTANCE; ++distance) {
+        const Slot& slot = this->slots[position];
+        if ((slot.meta & 0xFF) < distance + 1) {
+            break;
+        }
+        if (slot.meta == wanted) {
+            this->counters.Probe(distance + 1);
+            return slot.index;
+        }
+        ++wanted;
+        position = (position + 1) & this->mask;
+    }
+
+    this->counters.Probe(distance + 1);
+    return NOT_FOUND;
+}
+
+/**
+ * Put a reference to an entry into the slot array, displacing entries
+ * that are closer to their home slot
+ *
+ * @return false if a probe sequence would exceed MAX_DISTANCE; the slot
+ *         array must then be rebuilt larger
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::place(uint64_t hash, uint32_t index) {
+    Slot incoming = { makeMeta(hash, 0), index };
+    size_t position = hash & this->mask;
+
+    while (true) {
+        Slot& slot = this->slots[position];
+        if (slot.meta == 0) {
+            slot = incoming;
+            return true;
+        }
+        if (distanceOf(slot.meta) < distanceOf(incoming.meta)) {
+            std::swap(slot, incoming);
+        }
+        if (distanceOf(incoming.meta) == MAX_DISTANCE) {
+            return false;
+        }
+        ++incoming.meta;
+        position = (position + 1) & this->mask;
+    }
+}
+
+/**
+ * Rebuild the slot array with the given power-of-two capacity from the
+ * stored hashes, doubling again in the unlikely case of an overlong probe.
+ * Any growth in progress is completed by the rebuild.
+ *
+ * @param unplaced Optional flag per entry; flagged entries are left out
+ *        (used while bulk loading)
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::rebuild(size_t capacity,
+        const uint8_t* unplaced) {
+    SlotArray(this->oldSlots.get_allocator()).swap(this->oldSlots);
+    this->migrated = 0;
+
+    // a hash that sends hundreds of keys to one slot can never be placed,
+    // however large the table
+    size_t limit = capacity * 64;
+
+    bool placed = false;
+    while (!placed) {
+        if (capacity > limit) {
+            throw std::length_error("HashMap: hash function does not spread the keys");
+        }
+        SlotArray(capacity, this->slots.get_allocator()).swap(this->slots);
+        this->mask = capacity - 1;
+        placed = true;
+        for (uint32_t i = 0; i < this->entryCount && placed; ++i) {
+            if (unplaced == nullptr || !unplaced[i]) {
+                placed = this->place(this->entry(i).hash, i);
+            }
+        }
+        capacity *= 2;
+    }
+    this->growAt = static_cast<size_t>(this->slots.size() * this->maxLoadFactor);
+    this->counters.Rehash();
+}
+
+/**
+ * Double the slot array, all at once or (incremental growth) by setting
+ * the current array aside to be migrated a step at a time
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::grow() {
+    if (!this->incremental) {
+        this->rebuild(this->slots.size() * 2);
+        return;
+    }
+
+    this->migrate(this->oldSlots.size());		// finish any previous growth
+    size_t capacity = this->slots.size() * 2;
+    this->oldSlots.swap(this->slots);
+    this->oldMask = this->mask;
+    this->migrated = 0;
+    SlotArray(capacity, this->slots.get_allocator()).swap(this->slots);
+    this->mask = capacity - 1;
+    this->growAt = static_cast<size_t>(capacity * this->maxLoadFactor);
+    this->counters.Rehash();
+}
+
+/**
+ * Move up to count old slots into the current array, releasing the old
+ * array once it is empty
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::migrate(size_t count) {
+    size_t end = std::min(this->migrated + count, this->oldSlots.size());
+    for (; this->migrated < end; ++this->migrated) {
+        const Slot& slot = this->oldSlots[this->migrated];
+        if (slot.meta == 0 || slot.index == NOT_FOUND) {
+            continue;
+        }
+        if (!this->place(this->entry(slot.index).hash, slot.index)) {
+            this->rebuild(this->slots.size() * 2);	// places everything, old array included
+            return;
+        }
+    }
+    if (this->migrated == this->oldSlots.size()) {
+        SlotArray(this->oldSlots.get_allocator()).swap(this->oldSlots);
+        this->migrated = 0;
+    }
+}
+
+/**
+ * Point the slot that refers to entry from at entry to instead
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::repoint(uint32_t from, uint32_t to) {
+    // an entry sits between its home slot and the next empty slot
+    uint64_t hash = this->entry(from).hash;
+    for (size_t position = hash & this->mask; this->slots[position].meta != 0;
+            position = (position + 1) & this->mask) {
+        if (this->slots[position].index == from) {
+            this->slots[position].index = to;
+            return;
+        }
+    }
+    if (this->oldSlots.empty()) {
+        return;
+    }
+    for (size_t position = hash & this->oldMask; this->oldSlots[position].meta != 0;
+            position = (position + 1) & this->oldMask) {
+        if (position >= this->migrated && this->oldSlots[position].index == from) {
+            this->oldSlots[position].index = to;
+            return;
+        }
+    }
+}
+
+/**
+ * Smallest power-of-two slot count that holds count entries within the
+ * maximum load factor
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+size_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::capacityFor(size_t count) const {
+    size_t capacity = INITIAL_CAPACITY;
+    while (static_cast<size_t>(capacity * this->maxLoadFactor) < count) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * Storage for the entry after the last one, allocating its chunk if
+ * needed. Nothing is constructed there and the entry count is unchanged.
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+typename HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Entry*
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::nextEntry() {
+    if (this->entryCount / ENTRY_CHUNK == this->chunks.size()) {
+        this->chunks.push_back(EntryTraits::allocate(this->entryAllocator, ENTRY_CHUNK));
+    }
+    return &this->entry(this->entryCount);
+}
+
+/**
+ * Count the entry just constructed at nextEntry() and reference it from
+ * the slot array, growing first if needed. If that throws, the entry is
+ * destroyed and the map left as it was.
+ *
+ * @return true
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::linkEntry(uint64_t hash) {
+    uint32_t index = static_cast<uint32_t>(this->entryCount);
+    if (this->entryCount + 1 > this->growAt) {
+        try {
+            this->grow();				// only touches counted entries
+        } catch (...) {
+            EntryTraits::destroy(this->entryAllocator, &this->entry(index));
+            throw;
+        }
+    }
+    ++this->entryCount;
+
+    if (!this->place(hash, index)) {
+        size_t capacity = this->slots.size();
+        try {
+            this->rebuild(capacity * 2);		// the new entry is placed with the rest
+        } catch (std::length_error&) {
+            // leave the map as it was before this insert
+            --this->entryCount;
+            EntryTraits::destroy(this->entryAllocator, &this->entry(index));
+            this->rebuild(capacity);
+            throw;
+        }
+    }
+    this->counters.Insert();
+    return true;
+}
+
+/**
+ * Construct a new entry from args and reference it from the slot array.
+ * The caller has checked that its key is not present.
+ *
+ * @return true
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename... Args>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::insertEntry(uint64_t hash,
+        Args&&... args) {
+    EntryTraits::construct(this->entryAllocator, this->nextEntry(),
+            std::forward<Args>(args)..., hash);
+    return this->linkEntry(hash);
+}
+
+/**
+ * Unlink and destroy the entry of a key, keeping the entries dense by
+ * moving the last entry into the hole
+ *
+ * @return true if the key was found and removed
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename K>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::removeKey(const K& key) {
+    if (!this->oldSlots.empty()) {
+        this->migrate(MIGRATE_STEP);
+    }
+
+    uint64_t hash = this->hash(key);
+    uint32_t index;
+    size_t position = this->probe(this->slots, this->mask, 0, key, hash);
+
+    if (position != this->slots.size()) {
+        index = this->slots[position].index;
+        // backward-shift deletion: pull each following entry that is not
+        // in its home slot back by one, so no tombstone is left behind
+        size_t next = (position + 1) & this->mask;
+        while ((this->slots[next].meta & 0xFF) > 1) {
+            this->slots[position] = this->slots[next];
+            --this->slots[position].meta;
+            position = next;
+            next = (next + 1) & this->mask;
+        }
+        this->slots[position] = Slot{ 0, 0 };
+    } else if (!this->oldSlots.empty()
+            && (position = this->probe(this->oldSlots, this->oldMask, this->migrated,
+                    key, hash)) != this->oldSlots.size()) {
+        // the old array is frozen; the slot keeps its meta so probes
+        // through it still stop in the right place
+        index = this->oldSlots[position].index;
+        this->oldSlots[position].index = NOT_FOUND;
+    } else {
+        return false;
+    }
+
+    uint32_t last = static_cast<uint32_t>(this->entryCount - 1);
+    if (index != last) {
+        this->repoint(last, index);
+        this->entry(index) = std::move(this->entry(last));
+    }
+    EntryTraits::destroy(this->entryAllocator, &this->entry(last));
+    --this->entryCount;
+
+    // keep one spare chunk, so removing and inserting at a chunk boundary
+    // does not allocate every time
+    size_t used = (this->entryCount + ENTRY_CHUNK - 1) / ENTRY_CHUNK;
+    if (this->chunks.size() > used + 1) {
+        EntryTraits::deallocate(this->entryAllocator, this->chunks.back(), ENTRY_CHUNK);
+        this->chunks.pop_back();
+    }
+    this->counters.Remove();
+    return true;
+}
+
+//============================================================================
+// Insert, find and remove
+//============================================================================
+
+/**
+ * Insert a copy of a value; a value whose key is present replaces it
+ *
+ * @return true if the key was new
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Insert(const Value& value)
+        requires keyed {
+    return this->Insert(Value(value));
+}
+
+/**
+ * Insert a value, moving it into the map; a value whose key is present
+ * replaces it
+ *
+ * @return true if the key was new
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Insert(Value&& value)
+        requires keyed {
+    if (!this->oldSlots.empty()) {
+        this->migrate(MIGRATE_STEP);
+    }
+
+    const Key& key = KeyOf()(value);
+    uint64_t hash = this->hash(key);
+    uint32_t found = this->findIndex(key, hash);
+    if (found != NOT_FOUND) {
+        this->entry(found).value = std::move(value);
+        return false;
+    }
+    return this->insertEntry(hash, std::move(value));
+}
+
+/**
+ * Construct a value from args directly in the next free entry, then
+ * insert it. Its key is only known once it is built, so a value whose key
+ * is present is moved over the stored one and the new entry discarded.
+ *
+ * @return true if the key was new
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename... Args>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Emplace(Args&&... args)
+        requires keyed {
+    if (!this->oldSlots.empty()) {
+        this->migrate(MIGRATE_STEP);
+    }
+
+    Entry* stored = this->nextEntry();
+    EntryTraits::construct(this->entryAllocator, stored, std::in_place,
+            std::forward<Args>(args)...);
+    try {
+        const Key& key = KeyOf()(stored->value);
+        stored->hash = this->hash(key);
+        uint32_t found = this->findIndex(key, stored->hash);
+        if (found != NOT_FOUND) {
+            this->entry(found).value = std::move(stored->value);
+            EntryTraits::destroy(this->entryAllocator, stored);
+            return false;
+        }
+    } catch (...) {
+        EntryTraits::destroy(this->entryAllocator, stored);
+        throw;
+    }
+    return this->linkEntry(stored->hash);
+}
+
+/**
+ * Map a key to a value, replacing any value it had
+ *
+ * @return true if the key was new
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Insert(const Key& key, Value value)
+        requires (!keyed) {
+    if (!this->oldSlots.empty()) {
+        this->migrate(MIGRATE_STEP);
+    }
+
+    uint64_t hash = this->hash(key);
+    uint32_t found = this->findIndex(key, hash);
+    if (found != NOT_FOUND) {
+        this->entry(found).value = std::move(value);
+        return false;
+    }
+    return this->insertEntry(hash, key, std::move(value));
+}
+
+/**
+ * The value of a key, inserting a default-constructed one first if the
+ * key is not present (e.g. the list of bids for a fund)
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+Value& HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::operator[](const Key& key)
+        requires (!keyed) {
+    if (!this->oldSlots.empty()) {
+        this->migrate(MIGRATE_STEP);
+    }
+
+    uint64_t hash = this->hash(key);
+    uint32_t found = this->findIndex(key, hash);
+    if (found == NOT_FOUND) {
+        found = static_cast<uint32_t>(this->entryCount);
+        this->insertEntry(hash, key, Value());
+    }
+    return this->entry(found).value;
+}
+
+/**
+ * Find the value of a key without copying it
+ *
+ * @return pointer to the stored value, nullptr if not found. Removing a
+ *         key moves another entry into its place, so the pointer is only
+ *         valid until the next Remove.
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+typename HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Mapped*
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Find(const Key& key) {
+    uint32_t index = this->findIndex(key, this->hash(key));
+    return index == NOT_FOUND ? nullptr : &(this->entry(index).value);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+const Value* HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Find(const Key& key) const {
+    uint32_t index = this->findIndex(key, this->hash(key));
+    return index == NOT_FOUND ? nullptr : &(this->entry(index).value);
+}
+
+/**
+ * Heterogeneous lookup, e.g. by std::string_view without building a
+ * std::string
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename K>
+typename HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Mapped*
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Find(const K& key) requires transparent<K> {
+    uint32_t index = this->findIndex(key, this->hash(key));
+    return index == NOT_FOUND ? nullptr : &(this->entry(index).value);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename K>
+const Value* HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Find(const K& key) const
+        requires transparent<K> {
+    uint32_t index = this->findIndex(key, this->hash(key));
+    return index == NOT_FOUND ? nullptr : &(this->entry(index).value);
+}
+
+/**
+ * @return a copy of the value of a key, a default value if not found
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+Value HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Search(const Key& key) const {
+    const Value* found = this->Find(key);
+    return found != nullptr ? *found : Value();
+}
+
+/**
+ * The position of a key's entry in storage order, for callers that keep
+ * compact references to entries (e.g. a secondary index). An insert adds
+ * its entry at position Size() - 1, and a replace keeps the position. A
+ * Remove moves the last entry into the removed entry's position, so a
+ * caller holding positions updates that one entry.
+ *
+ * @return the position, or NO_INDEX if the key is not present
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename K>
+size_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::IndexOf(const K& key) const
+        requires std::is_same_v<K, Key> || transparent<K> {
+    uint32_t index = this->findIndex(key, this->hash(key));
+    return index == NOT_FOUND ? NO_INDEX : index;
+}
+
+/**
+ * @return the value at a position in storage order, below Size()
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+const Value& HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::At(size_t index) const {
+    return this->entry(index).value;
+}
+
+/**
+ * Look up a batch of keys, overlapping their cache misses. Keys go
+ * through in groups: the whole group is hashed and its home slots are
+ * prefetched, then each probe sequence is scanned for a fingerprint match
+ * and that entry prefetched, and only then are keys compared. A single
+ * lookup waits on each of those misses in turn; here a group's misses
+ * are outstanding together.
+ *
+ * @param keys Keys to look up (Key, or a type the hash and equality
+ *        accept directly, e.g. std::string_view)
+ * @param found Receives, at the same position as each key, a pointer to
+ *        its value or nullptr; valid until the next Insert or Remove
+ * @return the number of keys found
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<std::ranges::random_access_range Keys>
+size_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::SearchMany(const Keys& keys,
+        std::span<const Value*> found) const
+        requires std::is_same_v<std::ranges::range_value_t<Keys>, Key>
+                || transparent<std::ranges::range_value_t<Keys>> {
+    size_t count = std::ranges::size(keys);
+    if (found.size() < count) {
+        throw std::invalid_argument("HashMap: SearchMany needs an output per key");
+    }
+
+    auto key = std::ranges::begin(keys);
+    uint64_t hashes[PREFETCH_GROUP];
+    uint32_t candidates[PREFETCH_GROUP];
+    size_t hits = 0;
+    for (size_t first = 0; first < count; first += PREFETCH_GROUP) {
+        size_t group = std::min(PREFETCH_GROUP, count - first);
+
+        for (size_t i = 0; i < group; ++i) {
+            hashes[i] = this->hash(key[first + i]);
+            prefetch(&this->slots[hashes[i] & this->mask]);
+        }
+        for (size_t i = 0; i < group; ++i) {
+            candidates[i] = this->matchFingerprint(hashes[i]);
+            if (candidates[i] != NOT_FOUND) {
+                prefetch(&this->entry(candidates[i]));
+            }
+        }
+        for (size_t i = 0; i < group; ++i) {
+            uint32_t index = candidates[i];
+            // a fingerprint collision, or a key still in the old array
+            // while growing, takes the ordinary lookup
+            if (index == NOT_FOUND ? !this->oldSlots.empty()
+                    : !this->equal(keyOf(this->entry(index)), key[first + i])) {
+                index = this->findIndex(key[first + i], hashes[i]);
+            } else {
+                this->counters.Lookup(index != NOT_FOUND);
+            }
+            found[first + i] = index == NOT_FOUND ? nullptr : &(this->entry(index).value);
+            hits += index != NOT_FOUND;
+        }
+    }
+    return hits;
+}
+
+/**
+ * Remove a key and its value
+ *
+ * @return true if the key was found and removed
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Remove(const Key& key) {
+    return this->removeKey(key);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename K>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Remove(const K& key)
+        requires transparent<K> {
+    return this->removeKey(key);
+}
+
+//============================================================================
+// Bulk loading
+//============================================================================
+
+/**
+ * Run work(0) .. work(threads - 1) in parallel, the first on the calling
+ * thread, and rethrow the first exception any of them threw
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename Work>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::runParallel(size_t threads, Work work) {
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back([&work, &errors, t]() {
+            try {
+                work(t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    try {
+        work(0);
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * Place the new entries of one partition, Robin Hood style. Their home
+ * slots all lie in the partition's range and probes only move forward,
+ * so touching no slot at or past the end keeps partitions apart and lets
+ * different threads place them at once. An entry that would be pushed
+ * past the end (or past MAX_DISTANCE) is left for the caller.
+ *
+ * @param end One past the last slot of the partition
+ *
+ * @param indices New entries of the partition, in insertion order
+ * @param overflow Receives entries that could not be placed in the range
+ * @param duplicates Receives entries whose key was already placed; the
+ *        value is moved into the placed entry, since later values win
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::placePartition(size_t end,
+        const uint32_t* indices, size_t count, std::vector<uint32_t>& overflow,
+        std::vector<uint32_t>& duplicates) {
+    for (size_t n = 0; n < count; ++n) {
+        uint32_t index = indices[n];
+        Entry& incomingEntry = this->entry(index);
+        uint64_t hash = incomingEntry.hash;
+        size_t home = hash & this->mask;
+
+        // look for the key first, as probe() does, but within the range
+        uint32_t wanted = makeMeta(hash, 0);
+        uint32_t found = NOT_FOUND;
+        for (size_t position = home; position < end && position - home <= MAX_DISTANCE;
+                ++position, ++wanted) {
+            const Slot& slot = this->slots[position];
+            if ((slot.meta & 0xFF) < (wanted & 0xFF)) {
+                break;
+            }
+            if (slot.meta == wanted && this->equal(keyOf(this->entry(slot.index)),
+                    keyOf(incomingEntry))) {
+                found = slot.index;
+                break;
+            }
+        }
+        if (found != NOT_FOUND) {
+            this->entry(found).value = std::move(incomingEntry.value);
+            duplicates.push_back(index);
+            continue;
+        }
+
+        Slot incoming = { makeMeta(hash, 0), index };
+        for (size_t position = home; ; ++position) {
+            if (position == end) {
+                overflow.push_back(incoming.index);
+                break;
+            }
+            Slot& slot = this->slots[position];
+            if (slot.meta == 0) {
+                slot = incoming;
+                break;
+            }
+            if (distanceOf(slot.meta) < distanceOf(incoming.meta)) {
+                std::swap(slot, incoming);
+            }
+            if (distanceOf(incoming.meta) == MAX_DISTANCE) {
+                overflow.push_back(incoming.index);
+                break;
+            }
+            ++incoming.meta;
+        }
+    }
+}
+
+/**
+ * Remove a set of entries from the dense storage by moving the last entry
+ * into each hole, highest index first
+ *
+ * @param indices Entries to remove; sorted in place
+ * @param repointSlots true if the slot array refers to every remaining
+ *        entry and must follow the moves, false if it is rebuilt after
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::dropEntries(std::vector<uint32_t>& indices, bool repointSlots) {
+    std::sort(indices.begin(), indices.end(), std::greater<uint32_t>());
+    for (uint32_t index : indices) {
+        uint32_t last = static_cast<uint32_t>(this->entryCount - 1);
+        if (index != last) {
+            if (repointSlots) {
+                this->repoint(last, index);
+            }
+            this->entry(index) = std::move(this->entry(last));
+        }
+        EntryTraits::destroy(this->entryAllocator, &this->entry(last));
+        --this->entryCount;
+    }
+}
+
+/**
+ * Load many values at once, e.g. every row of a parsed CSV file, with the
+ * same result as inserting them in order (a later value replaces an
+ * earlier one with the same key).
+ *
+ * The map is sized once. The values are then copied (or moved, from an
+ * rvalue range) into place and hashed by all threads in parallel, and
+ * split by home slot into one contiguous slot range per thread, which
+ * each thread fills without locks. The few entries that would spill over
+ * a range boundary are placed afterwards. Small loads are inserted
+ * serially.
+ *
+ * @param values Random-access range of values
+ * @param threads Threads to use, 0 for one per hardware thread
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<std::ranges::random_access_range Range>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::BulkLoad(Range&& values, unsigned int threads) requires keyed {
+    size_t count = std::ranges::size(values);
+    auto element = std::ranges::begin(values);
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned int>(std::min<size_t>(threads, count / BULK_PER_THREAD + 1));
+
+    this->Reserve(this->entryCount + count);
+    if (!this->oldSlots.empty()) {
+        this->migrate(this->oldSlots.size());
+    }
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (std::is_lvalue_reference_v<Range>) {
+                this->Insert(element[i]);
+            } else {
+                this->Insert(std::move(element[i]));
+            }
+        }
+        return;
+    }
+
+    // construct and hash every new entry, each thread a slice of the values
+    size_t first = this->entryCount;
+    while (this->chunks.size() * ENTRY_CHUNK < first + count) {
+        this->chunks.push_back(EntryTraits::allocate(this->entryAllocator, ENTRY_CHUNK));
+    }
+    auto sliceBegin = [count, threads](size_t t) {
+        return count * t / threads;
+    };
+    std::vector<size_t> built(threads, 0);
+    try {
+        runParallel(threads, [&](size_t t) {
+            for (size_t i = sliceBegin(t); i < sliceBegin(t + 1); ++i) {
+                Entry* stored = &this->entry(first + i);
+                if constexpr (std::is_lvalue_reference_v<Range>) {
+                    EntryTraits::construct(this->entryAllocator, stored, element[i], uint64_t(0));
+                } else {
+                    EntryTraits::construct(this->entryAllocator, stored, std::move(element[i]),
+                            uint64_t(0));
+                }
+                stored->hash = this->hash(keyOf(*stored));
+                ++built[t];
+            }
+        });
+    } catch (...) {
+        for (size_t t = 0; t < threads; ++t) {
+            for (size_t i = sliceBegin(t); i < sliceBegin(t) + built[t]; ++i) {
+                EntryTraits::destroy(this->entryAllocator, &this->entry(first + i));
+            }
+        }
+        throw;
+    }
+    this->entryCount = first + count;
+
+    // partition p owns the slots [boundary[p], boundary[p + 1]); entries
+    // are grouped by partition with a counting sort that keeps their order
+    size_t capacity = this->slots.size();
+    int shift = std::countr_zero(capacity);
+    std::vector<size_t> boundary(threads + 1);
+    for (size_t p = 0; p <= threads; ++p) {
+        boundary[p] = (p * capacity + threads - 1) / threads;
+    }
+    auto partitionOf = [this, threads, shift](uint64_t hash) {
+        return static_cast<size_t>(((hash & this->mask) * threads) >> shift);
+    };
+
+    std::vector<size_t> offsets(threads * threads, 0);		// [thread][partition]
+    runParallel(threads, [&](size_t t) {
+        for (size_t i = sliceBegin(t); i < sliceBegin(t + 1); ++i) {
+            ++offsets[t * threads + partitionOf(this->entry(first + i).hash)];
+        }
+    });
+    std::vector<size_t> partitionStart(threads + 1, 0);
+    size_t running = 0;
+    for (size_t p = 0; p < threads; ++p) {
+        partitionStart[p] = running;
+        for (size_t t = 0; t < threads; ++t) {
+            size_t n = offsets[t * threads + p];
+            offsets[t * threads + p] = running;
+            running += n;
+        }
+    }
+    partitionStart[threads] = running;
+
+    std::vector<uint32_t> order(count);
+    runParallel(threads, [&](size_t t) {
+        for (size_t i = sliceBegin(t); i < sliceBegin(t + 1); ++i) {
+            size_t p = partitionOf(this->entry(first + i).hash);
+            order[offsets[t * threads + p]++] = static_cast<uint32_t>(first + i);
+        }
+    });
+
+    // place each partition on its own thread
+    std::vector<std::vector<uint32_t>> overflows(threads);
+    std::vector<std::vector<uint32_t>> duplicateLists(threads);
+    runParallel(threads, [&](size_t p) {
+        this->placePartition(boundary[p + 1], &order[partitionStart[p]],
+                partitionStart[p + 1] - partitionStart[p], overflows[p], duplicateLists[p]);
+    });
+
+    std::vector<uint32_t> overflow, duplicates;
+    for (size_t p = 0; p < threads; ++p) {
+        overflow.insert(overflow.end(), overflows[p].begin(), overflows[p].end());
+        duplicates.insert(duplicates.end(), duplicateLists[p].begin(), duplicateLists[p].end());
+    }
+    std::sort(overflow.begin(), overflow.end());
+
+    // place the spilled entries (new ones, or older ones they displaced)
+    // serially; whichever of two equal keys was loaded later keeps its
+    // value. Flags per entry: 1 = not placed, 2 = duplicate.
+    std::vector<uint8_t> unplaced(this->entryCount, 0);
+    for (uint32_t index : overflow) {
+        unplaced[index] = 1;
+    }
+    for (uint32_t index : duplicates) {
+        unplaced[index] = 2;
+    }
+    // place() would lose an entry on an overlong probe, so check first
+    auto fits = [this](uint64_t hash) {
+        uint32_t distance = 0;
+        for (size_t position = hash & this->mask; this->slots[position].meta != 0;
+                position = (position + 1) & this->mask) {
+            distance = std::min(distance, distanceOf(this->slots[position].meta));
+            if (distance == MAX_DISTANCE) {
+                return false;
+            }
+            ++distance;
+        }
+        return true;
+    };
+    size_t goodCapacity = this->slots.size();
+    size_t limit = goodCapacity * 64;		// as in rebuild()
+    try {
+        for (uint32_t index : overflow) {
+            uint64_t hash = this->entry(index).hash;
+            size_t position = this->probe(this->slots, this->mask, 0,
+                    keyOf(this->entry(index)), hash);
+            if (position != this->slots.size()) {
+                uint32_t placed = this->slots[position].index;
+                if (placed < index) {
+                    this->entry(placed).value = std::move(this->entry(index).value);
+                }
+                duplicates.push_back(index);
+                unplaced[index] = 2;
+                continue;
+            }
+            while (!fits(hash)) {
+                if (this->slots.size() * 2 > limit) {
+                    throw std::length_error("HashMap: hash function does not spread the keys");
+                }
+                goodCapacity = this->slots.size();
+                this->rebuild(goodCapacity * 2, unplaced.data());
+            }
+            this->place(hash, index);
+            unplaced[index] = 0;
+        }
+    } catch (std::length_error&) {
+        // the hash cannot spread the keys: keep what was placed, as
+        // Insert does, and drop the rest
+        for (uint32_t index : overflow) {
+            if (unplaced[index] == 1) {
+                duplicates.push_back(index);
+            }
+        }
+        this->dropEntries(duplicates, false);
+        this->rebuild(goodCapacity);
+        throw;
+    }
+
+    this->dropEntries(duplicates, true);
+}
+
+//============================================================================
+// Traversal and sizing
+//============================================================================
+
+/**
+ * Call visit(const Value&) (keyed form) or visit(const Key&, const Value&)
+ * (map form) for every entry. Entries are contiguous within each chunk,
+ * so this is a straight walk through memory.
+ *
+ * @param visit Function or lambda to call with each entry
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+template<typename Visitor>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::ForEach(Visitor visit) const {
+    for (size_t first = 0; first < this->entryCount; first += ENTRY_CHUNK) {
+        const Entry* chunk = this->chunks[first / ENTRY_CHUNK];
+        size_t count = std::min(ENTRY_CHUNK, this->entryCount - first);
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (keyed) {
+                visit(chunk[i].value);
+            } else {
+                visit(chunk[i].key, chunk[i].value);
+            }
+        }
+    }
+}
+
+/**
+ * @return an iterator to the first stored value, in storage order
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+typename HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::ConstIterator
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::begin() const requires keyed {
+    return ConstIterator(this, 0);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+typename HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::ConstIterator
+HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::end() const requires keyed {
+    return ConstIterator(this, this->entryCount);
+}
+
+/**
+ * Remove every entry, keeping the current capacity
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Clear() {
+    this->destroyEntries();
+    this->rebuild(this->slots.size());
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+size_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Size() const {
+    return this->entryCount;
+}
+
+/**
+ * Size the map for a number of entries up front, e.g. from the row count
+ * of a CSV file, so loading it never grows the slot array
+ *
+ * @param count Number of entries expected
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Reserve(size_t count) {
+    this->chunks.reserve((count + ENTRY_CHUNK - 1) / ENTRY_CHUNK);
+    size_t capacity = this->capacityFor(count);
+    if (capacity > this->slots.size()) {
+        this->rebuild(capacity);
+    }
+}
+
+/**
+ * Release the memory the map holds beyond its entries: the slot array is
+ * rebuilt at the smallest capacity that holds them within the maximum
+ * load factor (completing any incremental growth), and unused chunks are
+ * freed. For a map that has shrunk for good, e.g. after a purge of old
+ * bids; a map that will grow back is better left alone.
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::ShrinkToFit() {
+    size_t capacity = this->capacityFor(this->entryCount);
+    if (capacity < this->slots.size() || !this->oldSlots.empty()) {
+        this->rebuild(capacity);
+    }
+    size_t used = (this->entryCount + ENTRY_CHUNK - 1) / ENTRY_CHUNK;
+    while (this->chunks.size() > used) {
+        EntryTraits::deallocate(this->entryAllocator, this->chunks.back(), ENTRY_CHUNK);
+        this->chunks.pop_back();
+    }
+    this->chunks.shrink_to_fit();
+}
+
+/**
+ * @return the number of slots
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+size_t HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Capacity() const {
+    return this->slots.size();
+}
+
+/**
+ * @return the fraction of slots in use
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+float HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::LoadFactor() const {
+    return static_cast<float>(this->entryCount) / this->slots.size();
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+float HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::MaxLoadFactor() const {
+    return this->maxLoadFactor;
+}
+
+/**
+ * Change the load factor that triggers growth. Lower values trade memory
+ * for shorter probes; Robin Hood probing stays fast up to about 0.9.
+ *
+ * @param loadFactor New maximum, greater than 0 and at most 0.95
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::SetMaxLoadFactor(float loadFactor) {
+    if (!(loadFactor > 0.0f && loadFactor <= 0.95f)) {
+        throw std::invalid_argument("HashMap: max load factor must be in (0, 0.95]");
+    }
+    this->maxLoadFactor = loadFactor;
+    this->rebuild(this->capacityFor(this->entryCount));
+}
+
+/**
+ * Choose how the slot array grows. Incremental growth keeps the previous
+ * array beside the new one and migrates MIGRATE_STEP slots per insert or
+ * remove, so no single write pays for rehashing the whole map; lookups
+ * check both arrays meanwhile. Lookups are const and never migrate, so
+ * they can share the map with other readers.
+ *
+ * @param enabled true for incremental, false to rebuild all at once
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+void HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::SetIncrementalGrowth(bool enabled) {
+    this->incremental = enabled;
+    if (!enabled && !this->oldSlots.empty()) {
+        this->migrate(this->oldSlots.size());
+    }
+}
+
+/**
+ * @return true while an incremental growth is still migrating slots
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+bool HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Growing() const {
+    return !this->oldSlots.empty();
+}
+
+/**
+ * Report how the entries sit in the slot array: each slot is a bucket,
+ * an entry's probe length is its distance from its home slot, and the
+ * most loaded buckets are the home slots the most keys hash to. Walks
+ * every slot, so it is meant for diagnostics, not hot paths.
+ *
+ * @param hotCount How many of the most loaded home slots to list
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator, typename KeyOf>
+TableStats HashMap<Key, Value, Hash, KeyEqual, Allocator, KeyOf>::Stats(size_t hotCount) const {
+    TableStats stats;
+    stats.entries = this->entryCount;
+    stats.buckets = this->slots.size();
+
+    std::vector<uint32_t> homeLoads(this->slots.size(), 0);
+    for (size_t position = 0; position < this->slots.size(); ++position) {
+        uint32_t meta = this->slots[position].meta;
+        if (meta == 0) {
+            ++stats.emptyBuckets;
+            continue;
+        }
+        stats.AddProbe(distanceOf(meta));
+        ++homeLoads[(position - distanceOf(meta)) & this->mask];
+    }
+    // entries not yet migrated while growing
+    for (size_t position = this->migrated; position < this->oldSlots.size(); ++position) {
+        const Slot& slot = this->oldSlots[position];
+        if (slot.meta != 0 && slot.index != NOT_FOUND) {
+            stats.AddProbe(distanceOf(slot.meta));
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> bucketLoads;
+    for (size_t home = 0; home < homeLoads.size(); ++home) {
+        if (homeLoads[home] > 1) {
+            bucketLoads.emplace_back(home, homeLoads[home]);
+        }
+    }
+
+    stats.memoryBytes = sizeof(*this)
+            + (this->slots.capacity() + this->oldSlots.capacity()) * sizeof(Slot)
+            + this->chunks.capacity() * sizeof(Entry*)
+            + this->chunks.size() * ENTRY_CHUNK * sizeof(Entry);
+    stats.counts = this->counters.Snapshot();
+    stats.Finish(std::move(bucketLoads), hotCount);
+    return stats;
+}
+
+#endif /* HASHMAP_HPP_ */
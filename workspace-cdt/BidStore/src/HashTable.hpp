@@ -0,0 +1,131 @@
+//============================================================================
+// Name        : HashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Open-addressing (Robin Hood) hash table for bids
+//============================================================================
+
+#ifndef HASHTABLE_HPP_
+#define HASHTABLE_HPP_
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+#include "HashFunctions.hpp"
+#include "HashMap.hpp"
+#include "MappedHashTable.hpp"
+
+/**
+ * Key policy for tables of bids: a bid is keyed by its own id, so the id
+ * is not stored a second time
+ */
+struct BidIdOf {
+	const std::string& operator()(const Bid& bid) const {
+		return bid.bidId;
+	}
+};
+
+//============================================================================
+// Hash Table class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to
+ * implement a hash table with open addressing.
+ *
+ * This is HashMap (see HashMap.hpp) storing bids keyed by bidId: Robin
+ * Hood probing over a slot array of 8-byte references to densely stored
+ * bids, backward-shift removal, doubling at the maximum load factor (or
+ * incrementally, see SetIncrementalGrowth) and Reserve() for known sizes.
+ *
+ * The hash is a compile-time policy, hashBidId by default, so the probe
+ * loop calls it inline. To compare hash functions on the same data at run
+ * time, use FunctionHash as the policy.
+ *
+ * Save writes the table to a file that Open maps read-only (see
+ * MappedHashTable), for programs that look bids up without loading them.
+ *
+ * PrintAll and Export write every bid as a displayBid line, formatted by
+ * several threads into their own buffers and written at once (see
+ * writeBids), in storage order or sorted by bidId.
+ */
+template<typename Hash = BidIdHash>
+class BasicHashTable : public HashMap<std::string, Bid, Hash, std::equal_to<>,
+		HashAllocator<Bid>, BidIdOf> {
+
+public:
+	using HashMap<std::string, Bid, Hash, std::equal_to<>, HashAllocator<Bid>,
+			BidIdOf>::HashMap;
+
+	void PrintAll(BidOrder order = BidOrder::Storage) const;
+	void Export(std::ostream& out, BidOrder order = BidOrder::Storage,
+			unsigned int threads = 0) const;
+	void Save(const std::string& path) const;
+	static MappedHashTable Open(const std::string& path);
+};
+
+using HashTable = BasicHashTable<>;
+
+/**
+ * Print all bids
+ *
+ * @param order Storage (insertion order until a Remove moves the last
+ *        bid) or sorted by bidId
+ */
+template<typename Hash>
+void BasicHashTable<Hash>::PrintAll(BidOrder order) const {
+	this->Export(std::cout, order);
+}
+
+/**
+ * Write all bids as displayBid lines
+ *
+ * @param out Stream to write to
+ * @param order Storage order or sorted by bidId
+ * @param threads Formatting threads, 0 for one per hardware thread
+ */
+template<typename Hash>
+void BasicHashTable<Hash>::Export(std::ostream& out, BidOrder order,
+		unsigned int threads) const {
+	std::vector<const Bid*> bids;
+	bids.reserve(this->Size());
+	for (const Bid& bid : *this) {
+		bids.push_back(&bid);
+	}
+	if (order == BidOrder::ById) {
+		sortById(bids);
+	}
+	writeBids(out, bids, threads);
+}
+
+/**
+ * Write the bids to a table file, in storage order (the order ForEach
+ * gives, insertion order until a Remove moves the last bid)
+ *
+ * @param path The file to write, replaced if it exists
+ */
+template<typename Hash>
+void BasicHashTable<Hash>::Save(const std::string& path) const {
+	std::vector<const Bid*> bids;
+	bids.reserve(this->Size());
+	this->ForEach([&bids](const Bid& bid) {
+		bids.push_back(&bid);
+	});
+	MappedHashTable::Write(path, bids);
+}
+
+/**
+ * Map a table file written by Save, read-only
+ *
+ * @param path The file to map
+ */
+template<typename Hash>
+MappedHashTable BasicHashTable<Hash>::Open(const std::string& path) {
+	return MappedHashTable(path);
+}
+
+#endif /* HASHTABLE_HPP_ */
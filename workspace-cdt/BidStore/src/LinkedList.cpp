@@ -0,0 +1,193 @@
+//============================================================================
+// Name        : LinkedList.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Singly linked list of bids
+//============================================================================
+
+#include "LinkedList.hpp"
+
+using namespace std;
+
+/**
+ * Default constructor
+ */
+LinkedList::LinkedList() {
+    // Initialize housekeeping variables
+	// list is initially empty (i.e. no head or tail, and no elements)
+	this->head = nullptr;
+	this->tail = nullptr;
+	this->size = 0;
+}
+
+/**
+ * Destructor
+ */
+LinkedList::~LinkedList() {
+	Node* currentNode = this->head;		// free every node from the head on
+	while (currentNode != nullptr) {
+		Node* nextNode = currentNode->next;
+		delete currentNode;
+		currentNode = nextNode;
+	}
+}
+
+/**
+ * Link an already constructed node to the end of the list
+ */
+void LinkedList::append(Node* node) {
+	// Append the node to the list
+	if (this->head == nullptr) {		// list is empty
+		this->head = node;
+	} else {
+		if (this->tail != nullptr) {	// tail presently points to a node
+			this->tail->next = node;	// present tail is no longer tail
+		}
+	}
+
+	this->tail = node;					// appended node is new tail
+	this->size++;						// list size increases by node added
+
+	return;
+}
+
+/**
+ * Link an already constructed node to the start of the list
+ */
+void LinkedList::prepend(Node* node) {
+	// Prepend the node to the beginning of the list
+	if (this->head == nullptr) {		// list is empty
+		this->tail = node;
+	} else {
+		node->next = this->head;
+	}
+
+	this->head = node;					// prepended node is new head
+	this-> size++;						// list size increases by node added
+
+	return;
+}
+
+/**
+ * Append a copy of a bid to the end of the list
+ * @param bid The bid to be appended to the list
+ */
+void LinkedList::Append(const Bid& bid) {
+	this->append(new Node(bid));
+}
+
+/**
+ * Append a new bid to the end of the list, moving its strings into the node
+ * @param bid The bid to be appended to the list
+ */
+void LinkedList::Append(Bid&& bid) {
+	this->append(new Node(std::move(bid)));
+}
+
+/**
+ * Prepend a copy of a bid to the start of the list
+ * @param bid The bid to be prepended to the list
+ */
+void LinkedList::Prepend(const Bid& bid) {
+	this->prepend(new Node(bid));
+}
+
+/**
+ * Prepend a new bid to the start of the list, moving its strings into the node
+ * @param bid The bid to be prepended to the list
+ */
+void LinkedList::Prepend(Bid&& bid) {
+	this->prepend(new Node(std::move(bid)));
+}
+
+/**
+ * Simple output of all bids in the list
+ */
+void LinkedList::PrintList() const {
+    // Implement print logic
+	// iterate over each list node in succession and display the bid
+	this->ForEach(displayBid);
+
+	return;
+}
+
+/**
+ * Remove a specified bid
+ *
+ * @param bidId The bid id to remove from the list
+ * @return true if the bid was found and removed
+ */
+bool LinkedList::Remove(const string& bidId) {
+    // Implement remove logic
+
+	// Iterate over the bids, remembering the node before the current one
+	Node* previousNode = nullptr;
+	Node* currentNode = this->head;		// start at the list head
+
+	while (currentNode != nullptr) {
+		if (currentNode->bid.bidId.compare(bidId) == 0) {	// bid was found, remove it
+			// unlink the node, special casing the list head and tail
+			if (previousNode == nullptr) {
+				this->head = currentNode->next;
+			} else {
+				previousNode->next = currentNode->next;
+			}
+			if (this->tail == currentNode) {
+				this->tail = previousNode;
+			}
+
+			delete currentNode;
+			this->size--;
+			return true;
+		}
+
+		previousNode = currentNode;
+		currentNode = currentNode->next;
+	}
+
+	return false;
+}
+
+/**
+ * Find the specified bidId without copying the bid
+ *
+ * @param bidId The bid id to search for
+ * Returns a pointer to the stored bid, nullptr if not found
+ */
+const Bid* LinkedList::Find(const string& bidId) const {
+    // Implement search logic
+
+	// Iterate over the bids
+	const Node* currentNode = this->head;	// start at the list head
+
+	// iterate over each list node in succession
+	while (currentNode != nullptr) {
+		// early return of found bid if found
+		if (currentNode->bid.bidId.compare(bidId) == 0) {
+			return &(currentNode->bid);
+		}
+
+		currentNode = currentNode->next;
+	}
+
+	return nullptr;						// nothing found
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * Returns a copy of the bid if found, empty Bid otherwise
+ */
+Bid LinkedList::Search(const string& bidId) const {
+	const Bid* found = this->Find(bidId);
+	return found != nullptr ? *found : Bid();
+}
+
+/**
+ * Returns the current size (number of elements) in the list
+ */
+int LinkedList::Size() const {
+    return this->size;
+}
@@ -0,0 +1,107 @@
+//============================================================================
+// Name        : LinkedList.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Singly linked list of bids
+//============================================================================
+
+#ifndef LINKEDLIST_HPP_
+#define LINKEDLIST_HPP_
+
+#include <string>
+#include <utility>
+
+#include "Bid.hpp"
+
+//============================================================================
+// Linked-List class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to
+ * implement a linked-list.
+ */
+class LinkedList {
+
+private:
+    // Internal structure for list entries, housekeeping variables
+	// (i.e. the list node)
+	struct Node {
+		Bid bid;			// the actual Bid
+		Node* next;			// subsequent Bid pointer
+
+		// constructors
+		Node() {			// initialize a nullptr by default
+			next = nullptr;
+		}
+
+		// construct the node's bid in place from the Bid constructor's
+		// arguments (or a bid to copy or move)
+		template<typename... Args>
+		explicit Node(Args&&... args)
+			: bid(std::forward<Args>(args)...), next(nullptr) {
+		}
+	};
+
+	Node* head;				// head pointer (i.e. start of list)
+	Node* tail;				// tail pointer (i.e. end of list)
+	int size;				// count of list elements
+
+	void append(Node* node);
+	void prepend(Node* node);
+
+public:
+    LinkedList();
+    virtual ~LinkedList();
+    LinkedList(const LinkedList&) = delete;
+    LinkedList& operator=(const LinkedList&) = delete;
+    void Append(const Bid& bid);
+    void Append(Bid&& bid);
+    template<typename... Args>
+    void EmplaceBack(Args&&... args);
+    void Prepend(const Bid& bid);
+    void Prepend(Bid&& bid);
+    template<typename... Args>
+    void EmplaceFront(Args&&... args);
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void PrintList() const;
+    bool Remove(const std::string& bidId);
+    const Bid* Find(const std::string& bidId) const;
+    Bid Search(const std::string& bidId) const;
+    int Size() const;
+};
+
+/**
+ * Construct a bid in place at the end of the list
+ * @param args Arguments forwarded to the Bid constructor
+ */
+template<typename... Args>
+void LinkedList::EmplaceBack(Args&&... args) {
+	this->append(new Node(std::forward<Args>(args)...));
+}
+
+/**
+ * Construct a bid in place at the start of the list
+ * @param args Arguments forwarded to the Bid constructor
+ */
+template<typename... Args>
+void LinkedList::EmplaceFront(Args&&... args) {
+	this->prepend(new Node(std::forward<Args>(args)...));
+}
+
+/**
+ * Call visit(const Bid&) for every bid from head to tail
+ *
+ * @param visit Function or lambda to call with each bid
+ */
+template<typename Visitor>
+void LinkedList::ForEach(Visitor visit) const {
+	for (const Node* currentNode = this->head; currentNode != nullptr;
+			currentNode = currentNode->next) {
+		visit(currentNode->bid);
+	}
+}
+
+#endif /* LINKEDLIST_HPP_ */
@@ -0,0 +1,436 @@
+//============================================================================
+// Name        : MappedHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Read-only bid hash table memory-mapped from a file
+//============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "HashFunctions.hpp"
+#include "MappedHashTable.hpp"
+
+using namespace std;
+
+namespace {
+
+const char MAGIC[8] = { 'B', 'I', 'D', 'H', 'A', 'S', 'H', '\0' };
+const uint32_t VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;		// reads back differently if swapped
+const char HASH_CHECK_KEY[] = "98109";
+
+/**
+ * The start of a table file. Offsets are from the start of the file;
+ * every section is 8-byte aligned.
+ */
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t hashCheck;		// hashBidId(HASH_CHECK_KEY) when written
+    uint64_t bidCount;
+    uint64_t slotCount;		// a power of two, at least twice bidCount
+    uint64_t slotsOffset;
+    uint64_t recordsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+/**
+ * Append a string to the string section
+ *
+ * @return its offset in the section
+ */
+uint32_t appendText(vector<char>& strings, const string& text) {
+    if (strings.size() + text.size() > UINT32_MAX) {
+        throw length_error("MappedHashTable: strings exceed 4 GB");
+    }
+    uint32_t offset = static_cast<uint32_t>(strings.size());
+    strings.insert(strings.end(), text.begin(), text.end());
+    return offset;
+}
+
+/**
+ * A name beside path for the file being written, unique to this process
+ * and call, so concurrent writers of the same path do not share it
+ */
+string temporaryPath(const string& path) {
+    static atomic<unsigned long> counter{ 0 };
+#ifdef _WIN32
+    unsigned long process = static_cast<unsigned long>(_getpid());
+#else
+    unsigned long process = static_cast<unsigned long>(getpid());
+#endif
+    return path + ".tmp." + to_string(process) + "." + to_string(counter.fetch_add(1));
+}
+
+/**
+ * Flush a written file to the disk, so it is complete before it is
+ * renamed into place
+ *
+ * @return false if it could not be flushed
+ */
+bool syncFile(const string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool flushed = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    return flushed;
+#else
+    int fd = open(path.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool flushed = fsync(fd) == 0;
+    close(fd);
+    return flushed;
+#endif
+}
+
+/**
+ * Flush the directory holding a file, so a rename into it survives a
+ * crash. Best effort: Windows has no equivalent, and not every file
+ * system supports it.
+ */
+void syncDirectory(const string& path) {
+#ifndef _WIN32
+    string directory = filesystem::path(path).parent_path().string();
+    int fd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void) path;
+#endif
+}
+
+}
+
+/**
+ * Map a table file read-only
+ *
+ * @param path A file written by Write (or HashTable::Save)
+ * @throw runtime_error if the file cannot be mapped or is not a table
+ *        file this build can read
+ */
+MappedHashTable::MappedHashTable(const string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw runtime_error("MappedHashTable: cannot open " + path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw runtime_error("MappedHashTable: cannot stat " + path);
+    }
+    this->length = static_cast<size_t>(size.QuadPart);
+    if (this->length < sizeof(FileHeader)) {
+        CloseHandle(file);
+        throw runtime_error("MappedHashTable: " + path + " is not a table file");
+    }
+    HANDLE section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);					// the mapping keeps the file open
+    void* mapping = section != nullptr ? MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (section != nullptr) {
+        CloseHandle(section);			// and the view keeps the mapping
+    }
+    if (mapping == nullptr) {
+        throw runtime_error("MappedHashTable: cannot map " + path);
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("MappedHashTable: cannot open " + path + ": " + strerror(errno));
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        int error = errno;
+        close(fd);
+        throw runtime_error("MappedHashTable: cannot stat " + path + ": " + strerror(error));
+    }
+    this->length = static_cast<size_t>(status.st_size);
+    if (this->length < sizeof(FileHeader)) {
+        close(fd);
+        throw runtime_error("MappedHashTable: " + path + " is not a table file");
+    }
+    void* mapping = mmap(nullptr, this->length, PROT_READ, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);							// the mapping keeps the file open
+    if (mapping == MAP_FAILED) {
+        throw runtime_error("MappedHashTable: cannot map " + path + ": " + strerror(error));
+    }
+#endif
+    this->base = static_cast<const char*>(mapping);
+
+    FileHeader header;
+    memcpy(&header, this->base, sizeof(header));
+    const char* problem = nullptr;
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        problem = "is not a table file";
+    } else if (header.version != VERSION) {
+        problem = "has an unsupported version";
+    } else if (header.byteOrder != BYTE_ORDER_MARK) {
+        problem = "was written with the other byte order";
+    } else if (header.hashCheck != hashBidId(HASH_CHECK_KEY)) {
+        problem = "was written with a different bid id hash";
+    } else if (!has_single_bit(header.slotCount) || header.slotCount / 2 < header.bidCount
+            || header.bidCount >= UINT32_MAX
+            || header.slotsOffset < sizeof(header) || header.slotsOffset % 8 != 0
+            || header.recordsOffset % 8 != 0
+            // sections must lie in order inside the file; check that before
+            // subtracting offsets, and compare counts against the space
+            // between offsets so no offset + size sum can wrap
+            || header.slotsOffset > header.recordsOffset
+            || header.recordsOffset > header.stringsOffset
+            || header.stringsOffset > this->length
+            || header.slotCount > (header.recordsOffset - header.slotsOffset) / sizeof(Slot)
+            || header.bidCount > (header.stringsOffset - header.recordsOffset) / sizeof(MappedBidRecord)
+            || header.stringsSize > this->length - header.stringsOffset) {
+        problem = "is truncated or corrupt";
+    }
+    if (problem != nullptr) {
+        this->unmap();
+        throw runtime_error("MappedHashTable: " + path + " " + problem);
+    }
+
+    this->slots = reinterpret_cast<const Slot*>(this->base + header.slotsOffset);
+    this->records = reinterpret_cast<const MappedBidRecord*>(this->base + header.recordsOffset);
+    this->strings = this->base + header.stringsOffset;
+    this->bidCount = header.bidCount;
+    this->slotMask = header.slotCount - 1;
+    this->stringsSize = header.stringsSize;
+}
+
+MappedHashTable::MappedHashTable(MappedHashTable&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedHashTable& MappedHashTable::operator=(MappedHashTable&& other) noexcept {
+    if (this != &other) {
+        this->unmap();
+        this->base = exchange(other.base, nullptr);
+        this->length = exchange(other.length, 0);
+        this->slots = exchange(other.slots, nullptr);
+        this->records = exchange(other.records, nullptr);
+        this->strings = exchange(other.strings, nullptr);
+        this->bidCount = exchange(other.bidCount, 0);
+        this->slotMask = exchange(other.slotMask, 0);
+        this->stringsSize = exchange(other.stringsSize, 0);
+    }
+    return *this;
+}
+
+MappedHashTable::~MappedHashTable() {
+    this->unmap();
+}
+
+void MappedHashTable::unmap() {
+    if (this->base != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(this->base);
+#else
+        munmap(const_cast<char*>(this->base), this->length);
+#endif
+        this->base = nullptr;
+    }
+}
+
+/**
+ * Write a table file. It is written beside the target under a name of
+ * its own, flushed to disk and renamed over the target, so processes
+ * that have the old file mapped keep reading the old file, ones that
+ * open the path get the old or the new one whole (also after a crash),
+ * and concurrent writers of one path do not mix their files; the last
+ * rename wins. (Windows refuses to replace a file another process still
+ * has mapped; the write then fails and the old file stays.)
+ *
+ * @param path The file to write
+ * @param bids The bids, with distinct ids, in the order ForEach will
+ *        give them
+ * @throw length_error if the strings do not fit the 32-bit offsets
+ * @throw runtime_error if the file cannot be written
+ */
+void MappedHashTable::Write(const string& path, const vector<const Bid*>& bids) {
+    if (bids.size() >= UINT32_MAX) {
+        throw length_error("MappedHashTable: too many bids");
+    }
+    FileHeader header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.hashCheck = hashBidId(HASH_CHECK_KEY);
+    header.bidCount = bids.size();
+    header.slotCount = bit_ceil(max<uint64_t>(8, bids.size() * 2));
+    header.slotsOffset = align8(sizeof(header));
+    header.recordsOffset = header.slotsOffset + header.slotCount * sizeof(Slot);
+
+    vector<Slot> slots(header.slotCount, Slot{ 0, 0 });
+    vector<MappedBidRecord> records(bids.size());
+    vector<char> strings;
+    size_t mask = header.slotCount - 1;
+    for (size_t i = 0; i < bids.size(); ++i) {
+        const Bid& bid = *bids[i];
+        MappedBidRecord& record = records[i];
+        record.idLength = static_cast<uint32_t>(bid.bidId.size());
+        record.idOffset = appendText(strings, bid.bidId);
+        record.titleLength = static_cast<uint32_t>(bid.title.size());
+        record.titleOffset = appendText(strings, bid.title);
+        record.fundLength = static_cast<uint32_t>(bid.fund.size());
+        record.fundOffset = appendText(strings, bid.fund);
+        record.amount = bid.amount;
+
+        uint64_t hash = hashBidId(bid.bidId);
+        size_t position = hash & mask;
+        while (slots[position].record != 0) {
+            position = (position + 1) & mask;
+        }
+        slots[position].fingerprint = static_cast<uint32_t>(hash >> 32);
+        slots[position].record = static_cast<uint32_t>(i + 1);
+    }
+    header.stringsOffset = header.recordsOffset + records.size() * sizeof(MappedBidRecord);
+    header.stringsSize = strings.size();
+
+    string temporary = temporaryPath(path);
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        const char padding[8] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(padding, header.slotsOffset - sizeof(header));
+        file.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(Slot));
+        file.write(reinterpret_cast<const char*>(records.data()),
+                records.size() * sizeof(MappedBidRecord));
+        file.write(strings.data(), strings.size());
+        file.close();
+        if (!file || !syncFile(temporary)) {
+            error_code ignored;
+            filesystem::remove(temporary, ignored);
+            throw runtime_error("MappedHashTable: cannot write " + temporary);
+        }
+    }
+    error_code error;
+    filesystem::rename(temporary, path, error);
+    if (error) {
+        error_code ignored;
+        filesystem::remove(temporary, ignored);
+        throw runtime_error("MappedHashTable: cannot replace " + path + ": " + error.message());
+    }
+    syncDirectory(path);
+}
+
+/**
+ * The string at an offset of the string section
+ *
+ * @throw runtime_error if it runs past the section (a corrupt file)
+ */
+string_view MappedHashTable::text(uint32_t offset, uint32_t length) const {
+    if (offset > this->stringsSize || length > this->stringsSize - offset) {
+        throw runtime_error("MappedHashTable: corrupt string offset");
+    }
+    return string_view(this->strings + offset, length);
+}
+
+/**
+ * Find the record of a bid id in the mapped file
+ *
+ * @return pointer into the mapping, nullptr if not found; valid while
+ *         the table is open
+ */
+const MappedBidRecord* MappedHashTable::Find(string_view bidId) const {
+    uint64_t hash = hashBidId(bidId);
+    uint32_t fingerprint = static_cast<uint32_t>(hash >> 32);
+    // a valid file uses at most half the slots, so the probe meets an empty
+    // one; the bound only stops a corrupt file with none from looping
+    size_t position = hash & this->slotMask;
+    for (size_t probes = 0; probes <= this->slotMask; ++probes,
+            position = (position + 1) & this->slotMask) {
+        const Slot& slot = this->slots[position];
+        if (slot.record == 0) {
+            return nullptr;
+        }
+        if (slot.fingerprint == fingerprint && slot.record <= this->bidCount) {
+            const MappedBidRecord& record = this->records[slot.record - 1];
+            if (this->BidId(record) == bidId) {
+                return &record;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid MappedHashTable::Search(const string& bidId) const {
+    const MappedBidRecord* record = this->Find(bidId);
+    return record != nullptr ? this->ToBid(*record) : Bid();
+}
+
+void MappedHashTable::PrintAll() const {
+    this->ForEach([this](const MappedBidRecord& record) {
+        displayBid(this->ToBid(record));
+    });
+}
+
+size_t MappedHashTable::Size() const {
+    return this->bidCount;
+}
+
+size_t MappedHashTable::FileSize() const {
+    return this->length;
+}
+
+string_view MappedHashTable::BidId(const MappedBidRecord& record) const {
+    return this->text(record.idOffset, record.idLength);
+}
+
+string_view MappedHashTable::Title(const MappedBidRecord& record) const {
+    return this->text(record.titleOffset, record.titleLength);
+}
+
+string_view MappedHashTable::Fund(const MappedBidRecord& record) const {
+    return this->text(record.fundOffset, record.fundLength);
+}
+
+/**
+ * Copy a record out of the mapping into an ordinary Bid
+ */
+Bid MappedHashTable::ToBid(const MappedBidRecord& record) const {
+    return Bid(string(this->BidId(record)), string(this->Title(record)),
+            string(this->Fund(record)), record.amount);
+}
@@ -0,0 +1,116 @@
+//============================================================================
+// Name        : MappedHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Read-only bid hash table memory-mapped from a file
+//============================================================================
+
+#ifndef MAPPEDHASHTABLE_HPP_
+#define MAPPEDHASHTABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Bid.hpp"
+
+/**
+ * A bid as stored in a table file: its strings are offset/length pairs
+ * into the file's string section, so the record means the same thing
+ * wherever the file is mapped.
+ */
+struct MappedBidRecord {
+    uint32_t idOffset;
+    uint32_t idLength;
+    uint32_t titleOffset;
+    uint32_t titleLength;
+    uint32_t fundOffset;
+    uint32_t fundLength;
+    double amount;
+};
+
+static_assert(sizeof(MappedBidRecord) == 32, "MappedBidRecord is part of the file format");
+
+//============================================================================
+// Mapped Hash Table class definition
+//============================================================================
+
+/**
+ * A table file written by HashTable::Save, mapped read-only.
+ *
+ * The file holds a header, an open-addressing slot array, the bid records
+ * and one section of strings, and refers to nothing outside itself by
+ * address: slots name records by index and records name strings by
+ * offset. Opening it is one mmap (MapViewOfFile on Windows) and a
+ * header check, and lookups read the mapped pages directly, so every
+ * process that opens the same file shares one copy of it in the page
+ * cache and starts without parsing anything.
+ *
+ * Slots are probed linearly from hashBidId(id), at a load factor of at
+ * most 1/2; each holds the upper half of its id's hash, so a lookup
+ * compares ids only when those match. The file is in the writer's byte
+ * order, and the header records it and a check value of the hash
+ * function so a file from another platform or an older hash is refused
+ * rather than misread.
+ */
+class MappedHashTable {
+
+private:
+    struct Slot {
+        uint32_t fingerprint;	// upper half of the id's hash
+        uint32_t record;		// record index + 1, 0 if the slot is empty
+    };
+
+    const char* base = nullptr;				// the mapping
+    size_t length = 0;
+    const Slot* slots = nullptr;
+    const MappedBidRecord* records = nullptr;
+    const char* strings = nullptr;
+    size_t bidCount = 0;
+    size_t slotMask = 0;
+    size_t stringsSize = 0;
+
+    std::string_view text(uint32_t offset, uint32_t length) const;
+    void unmap();
+
+public:
+    explicit MappedHashTable(const std::string& path);
+    MappedHashTable(MappedHashTable&& other) noexcept;
+    MappedHashTable& operator=(MappedHashTable&& other) noexcept;
+    MappedHashTable(const MappedHashTable&) = delete;
+    MappedHashTable& operator=(const MappedHashTable&) = delete;
+    virtual ~MappedHashTable();
+
+    static void Write(const std::string& path, const std::vector<const Bid*>& bids);
+
+    const MappedBidRecord* Find(std::string_view bidId) const;
+    Bid Search(const std::string& bidId) const;
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void PrintAll() const;
+    size_t Size() const;
+    size_t FileSize() const;
+
+    std::string_view BidId(const MappedBidRecord& record) const;
+    std::string_view Title(const MappedBidRecord& record) const;
+    std::string_view Fund(const MappedBidRecord& record) const;
+    Bid ToBid(const MappedBidRecord& record) const;
+};
+
+/**
+ * Call visit(const MappedBidRecord&) for every bid, in file order (the
+ * order of the table that was saved)
+ *
+ * @param visit Function or lambda to call with each record
+ */
+template<typename Visitor>
+void MappedHashTable::ForEach(Visitor visit) const {
+    for (size_t i = 0; i < this->bidCount; ++i) {
+        visit(this->records[i]);
+    }
+}
+
+#endif /* MAPPEDHASHTABLE_HPP_ */
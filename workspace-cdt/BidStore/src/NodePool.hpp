@@ -0,0 +1,185 @@
+//============================================================================
+// Name        : NodePool.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Slab allocator for the nodes of linked containers
+//============================================================================
+
+#ifndef NODEPOOL_HPP_
+#define NODEPOOL_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+//============================================================================
+// Node Pool class definition
+//============================================================================
+
+/**
+ * Hands out storage for nodes of one type from blocks of NodesPerBlock
+ * nodes. Freed nodes go on a free list and are reused before a block is
+ * touched, so a container that inserts and removes at a steady size stops
+ * allocating altogether, and nodes allocated together sit together.
+ *
+ * The pool releases its blocks, not the objects in them: the owner
+ * destroys any live nodes first (unless they are trivially
+ * destructible), then dropping the pool frees everything in one call per
+ * block.
+ */
+template<typename T, size_t NodesPerBlock = 256>
+class NodePool {
+
+private:
+    // a slot holds a live node or, once freed, the link to the next free slot
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    size_t usedInBlock = NodesPerBlock;		// slots handed out from the last block
+    Slot* freeList = nullptr;
+    size_t liveCount = 0;
+
+public:
+    static constexpr size_t NODES_PER_BLOCK = NodesPerBlock;
+
+    NodePool() = default;
+    NodePool(NodePool&& other) noexcept;
+    NodePool& operator=(NodePool&& other) noexcept;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template<typename... Args>
+    T* New(Args&&... args);
+    void Delete(T* node);
+    void Reserve(size_t count);
+    void Release();
+    size_t Live() const;
+    size_t BlockCount() const;
+};
+
+template<typename T, size_t NodesPerBlock>
+NodePool<T, NodesPerBlock>::NodePool(NodePool&& other) noexcept
+        : blocks(std::move(other.blocks)),
+          usedInBlock(std::exchange(other.usedInBlock, NodesPerBlock)),
+          freeList(std::exchange(other.freeList, nullptr)),
+          liveCount(std::exchange(other.liveCount, 0)) {
+}
+
+template<typename T, size_t NodesPerBlock>
+NodePool<T, NodesPerBlock>& NodePool<T, NodesPerBlock>::operator=(NodePool&& other) noexcept {
+    if (this != &other) {
+        this->blocks = std::move(other.blocks);
+        this->usedInBlock = std::exchange(other.usedInBlock, NodesPerBlock);
+        this->freeList = std::exchange(other.freeList, nullptr);
+        this->liveCount = std::exchange(other.liveCount, 0);
+    }
+    return *this;
+}
+
+/**
+ * Construct a node in pooled storage
+ *
+ * @param args Arguments forwarded to the node's constructor
+ * @return the new node, to be returned with Delete()
+ */
+template<typename T, size_t NodesPerBlock>
+template<typename... Args>
+T* NodePool<T, NodesPerBlock>::New(Args&&... args) {
+    Slot* slot;
+    if (this->freeList != nullptr) {
+        slot = this->freeList;
+        this->freeList = slot->next;
+    } else {
+        if (this->usedInBlock == NodesPerBlock) {
+            this->blocks.emplace_back(new Slot[NodesPerBlock]);
+            this->usedInBlock = 0;
+        }
+        slot = &this->blocks.back()[this->usedInBlock++];
+    }
+
+    T* node;
+    try {
+        node = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        slot->next = this->freeList;
+        this->freeList = slot;
+        throw;
+    }
+    ++this->liveCount;
+    return node;
+}
+
+/**
+ * Destroy a node and put its storage on the free list
+ *
+ * @param node A node from New(), or nullptr
+ */
+template<typename T, size_t NodesPerBlock>
+void NodePool<T, NodesPerBlock>::Delete(T* node) {
+    if (node == nullptr) {
+        return;
+    }
+    node->~T();
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = this->freeList;
+    this->freeList = slot;
+    --this->liveCount;
+}
+
+/**
+ * Allocate blocks up front for a number of nodes, e.g. before a bulk load
+ *
+ * @param count Nodes expected to be live at once
+ */
+template<typename T, size_t NodesPerBlock>
+void NodePool<T, NodesPerBlock>::Reserve(size_t count) {
+    size_t needed = count > this->liveCount ? count - this->liveCount : 0;
+    size_t available = NodesPerBlock - this->usedInBlock;
+    for (Slot* slot = this->freeList; slot != nullptr && available < needed; slot = slot->next) {
+        ++available;
+    }
+    while (available < needed) {
+        // the current block's unused tail goes on the free list first
+        for (; this->usedInBlock < NodesPerBlock; ++this->usedInBlock) {
+            Slot* slot = &this->blocks.back()[this->usedInBlock];
+            slot->next = this->freeList;
+            this->freeList = slot;
+        }
+        this->blocks.emplace_back(new Slot[NodesPerBlock]);
+        this->usedInBlock = 0;
+        available += NodesPerBlock;
+    }
+}
+
+/**
+ * Free every block without destroying the nodes in them. The owner must
+ * already have destroyed any live nodes that need it.
+ */
+template<typename T, size_t NodesPerBlock>
+void NodePool<T, NodesPerBlock>::Release() {
+    this->blocks.clear();
+    this->usedInBlock = NodesPerBlock;
+    this->freeList = nullptr;
+    this->liveCount = 0;
+}
+
+/**
+ * @return the number of nodes handed out and not yet deleted
+ */
+template<typename T, size_t NodesPerBlock>
+size_t NodePool<T, NodesPerBlock>::Live() const {
+    return this->liveCount;
+}
+
+template<typename T, size_t NodesPerBlock>
+size_t NodePool<T, NodesPerBlock>::BlockCount() const {
+    return this->blocks.size();
+}
+
+#endif /* NODEPOOL_HPP_ */
@@ -0,0 +1,284 @@
+//============================================================================
+// Name        : PerfectHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Read-only bid table indexed by a minimal perfect hash
+//============================================================================
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "PerfectHashTable.hpp"
+
+using namespace std;
+
+namespace {
+
+// buckets per id: BUCKETS_PER_LOG_KEYS / log2(ids); fewer buckets mean
+// fewer bits per id but longer pilot searches
+const double BUCKETS_PER_LOG_KEYS = 6.0;
+const uint64_t DENSE_SHARE = 0x999999999999999Aull;	// 0.6 * 2^64
+const size_t MAX_PILOT = 1 << 20;					// give up on the seed past this
+const uint64_t MAX_SEEDS = 16;
+
+/**
+ * Map a hash uniformly onto [0, range) with a multiply instead of a
+ * division
+ */
+inline size_t reduce(uint64_t hash, size_t range) {
+    uint64_t high = range;
+    multiply128(hash, high);
+    return high;
+}
+
+inline size_t positionFor(uint64_t hash, uint64_t pilot, size_t tableSize) {
+    return reduce(mixInteger(hash ^ mixInteger(pilot)), tableSize);
+}
+
+}
+
+/**
+ * Build the index over a set of bids
+ *
+ * @param source Bids with distinct ids
+ * @throw invalid_argument if two bids share an id
+ */
+PerfectHashTable::PerfectHashTable(vector<Bid> source) {
+    vector<uint64_t> hashes(source.size());
+    for (this->seed = 0; this->seed < MAX_SEEDS; ++this->seed) {
+        for (size_t i = 0; i < source.size(); ++i) {
+            hashes[i] = this->hash(source[i].bidId);
+        }
+        if (this->build(source, hashes)) {
+            return;
+        }
+    }
+    throw runtime_error("PerfectHashTable: no seed gave a perfect hash");
+}
+
+/**
+ * Snapshot a loaded HashTable. The table is left as it is; later changes
+ * to it are not seen here.
+ */
+PerfectHashTable::PerfectHashTable(const HashTable& table)
+        : PerfectHashTable([&table]() {
+            vector<Bid> source;
+            source.reserve(table.Size());
+            table.ForEach([&source](const Bid& bid) {
+                source.push_back(bid);
+            });
+            return source;
+        }()) {
+}
+
+uint64_t PerfectHashTable::hash(string_view bidId) const {
+    return hashBytes(bidId.data(), bidId.size(), this->seed);
+}
+
+/**
+ * The bucket of a hash: 60% of hashes land in the first 30% of the
+ * buckets, so the big buckets are placed while the table is still empty
+ */
+size_t PerfectHashTable::bucketOf(uint64_t hash) const {
+    uint64_t spread = mixInteger(hash);
+    if (hash < DENSE_SHARE) {
+        return reduce(spread, this->denseBuckets);
+    }
+    return this->denseBuckets + reduce(spread, this->pilots.size() - this->denseBuckets);
+}
+
+uint64_t PerfectHashTable::pilotOf(size_t bucket) const {
+    uint8_t pilot = this->pilots[bucket];
+    if (pilot != LARGE_PILOT) {
+        return pilot;
+    }
+    auto large = lower_bound(this->largePilots.begin(), this->largePilots.end(),
+            make_pair(static_cast<uint32_t>(bucket), uint32_t(0)));
+    return large->second;
+}
+
+/**
+ * The position of a loaded id's hash in the dense array
+ */
+size_t PerfectHashTable::positionOf(uint64_t hash) const {
+    size_t position = positionFor(hash, this->pilotOf(this->bucketOf(hash)), this->tableSize);
+    return position < this->bids.size() ? position : this->remap[position - this->bids.size()];
+}
+
+/**
+ * Search for pilots with the current seed and, if every bucket gets one,
+ * move the bids into place
+ *
+ * @param hashes The ids' hashes under the current seed
+ * @return false if the seed does not work (two ids hash alike, or a
+ *         bucket finds no pilot); nothing has been moved then
+ */
+bool PerfectHashTable::build(vector<Bid>& source, const vector<uint64_t>& hashes) {
+    size_t count = source.size();
+    size_t logCount = max<size_t>(bit_width(count), 1);
+    size_t bucketCount = max<size_t>(2, static_cast<size_t>(BUCKETS_PER_LOG_KEYS * count / logCount));
+    this->pilots.assign(bucketCount, 0);
+    this->largePilots.clear();
+    this->denseBuckets = max<size_t>(1, bucketCount * 3 / 10);
+    this->tableSize = count + count / 49 + 1;		// load factor 0.98
+
+    // group the ids by bucket
+    vector<uint32_t> bucketOfId(count);
+    vector<uint32_t> bucketStart(bucketCount + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        bucketOfId[i] = static_cast<uint32_t>(this->bucketOf(hashes[i]));
+        ++bucketStart[bucketOfId[i] + 1];
+    }
+    size_t largestBucket = 0;
+    for (size_t b = 0; b < bucketCount; ++b) {
+        largestBucket = max<size_t>(largestBucket, bucketStart[b + 1]);
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    vector<uint32_t> ids(count);
+    {
+        vector<uint32_t> next(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t i = 0; i < count; ++i) {
+            ids[next[bucketOfId[i]]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // largest buckets first, while most positions are free
+    vector<uint32_t> order;
+    order.reserve(bucketCount);
+    {
+        vector<vector<uint32_t>> bySize(largestBucket + 1);
+        for (size_t b = 0; b < bucketCount; ++b) {
+            bySize[bucketStart[b + 1] - bucketStart[b]].push_back(static_cast<uint32_t>(b));
+        }
+        for (size_t size = largestBucket; size > 0; --size) {
+            order.insert(order.end(), bySize[size].begin(), bySize[size].end());
+        }
+    }
+
+    vector<uint64_t> taken((this->tableSize + 63) / 64, 0);
+    auto isTaken = [&taken](size_t position) {
+        return (taken[position / 64] >> (position % 64)) & 1;
+    };
+    vector<uint32_t> positionOfId(count);
+    vector<size_t> positions;
+    for (uint32_t bucket : order) {
+        const uint32_t* first = &ids[bucketStart[bucket]];
+        size_t size = bucketStart[bucket + 1] - bucketStart[bucket];
+
+        // ids with the same hash always collide: a new seed may separate
+        // them, unless they are the same id
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = i + 1; j < size; ++j) {
+                if (hashes[first[i]] == hashes[first[j]]) {
+                    if (source[first[i]].bidId == source[first[j]].bidId) {
+                        throw invalid_argument("PerfectHashTable: duplicate bid id "
+                                + source[first[i]].bidId);
+                    }
+                    return false;
+                }
+            }
+        }
+
+        uint64_t pilot = 0;
+        for (; ; ++pilot) {
+            if (pilot > MAX_PILOT) {
+                return false;
+            }
+            positions.clear();
+            for (size_t i = 0; i < size; ++i) {
+                size_t position = positionFor(hashes[first[i]], pilot, this->tableSize);
+                if (isTaken(position)
+                        || find(positions.begin(), positions.end(), position) != positions.end()) {
+                    break;
+                }
+                positions.push_back(position);
+            }
+            if (positions.size() == size) {
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            taken[positions[i] / 64] |= uint64_t(1) << (positions[i] % 64);
+            positionOfId[first[i]] = static_cast<uint32_t>(positions[i]);
+        }
+        if (pilot < LARGE_PILOT) {
+            this->pilots[bucket] = static_cast<uint8_t>(pilot);
+        } else {
+            this->pilots[bucket] = LARGE_PILOT;
+            this->largePilots.emplace_back(bucket, static_cast<uint32_t>(pilot));
+        }
+    }
+    sort(this->largePilots.begin(), this->largePilots.end());
+
+    // the ids past the end fill the holes below it, in order
+    this->remap.assign(this->tableSize - count, 0);
+    size_t hole = 0;
+    for (size_t position = count; position < this->tableSize; ++position) {
+        if (isTaken(position)) {
+            while (isTaken(hole)) {
+                ++hole;
+            }
+            this->remap[position - count] = static_cast<uint32_t>(hole++);
+        }
+    }
+
+    this->bids.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t position = positionOfId[i];
+        if (position >= count) {
+            position = this->remap[position - count];
+        }
+        this->bids[position] = std::move(source[i]);
+    }
+    return true;
+}
+
+/**
+ * Find the bid with an id without copying it
+ *
+ * @return pointer to the bid, nullptr if not found
+ */
+const Bid* PerfectHashTable::Find(string_view bidId) const {
+    if (this->bids.empty()) {
+        return nullptr;
+    }
+    // every id maps somewhere, so the compare is what rejects unknown ids
+    const Bid& bid = this->bids[this->positionOf(this->hash(bidId))];
+    return bid.bidId == bidId ? &bid : nullptr;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid PerfectHashTable::Search(const string& bidId) const {
+    const Bid* bid = this->Find(bidId);
+    return bid != nullptr ? *bid : Bid();
+}
+
+void PerfectHashTable::PrintAll() const {
+    this->ForEach(displayBid);
+}
+
+size_t PerfectHashTable::Size() const {
+    return this->bids.size();
+}
+
+size_t PerfectHashTable::BucketCount() const {
+    return this->pilots.size();
+}
+
+/**
+ * @return the index's memory, beyond the bids themselves, per bid
+ */
+double PerfectHashTable::BitsPerKey() const {
+    size_t bytes = this->pilots.size() * sizeof(uint8_t)
+            + this->largePilots.size() * sizeof(this->largePilots[0])
+            + this->remap.size() * sizeof(uint32_t);
+    return this->bids.empty() ? 0.0 : bytes * 8.0 / this->bids.size();
+}
@@ -0,0 +1,340 @@
+//============================================================================
+// Name        : ShardedHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bid table split into shards, each owned by a worker thread
+//============================================================================
+
+#include <algorithm>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "HashFunctions.hpp"
+#include "ShardedHashTable.hpp"
+
+using namespace std;
+
+namespace {
+
+/**
+ * Completion of a batch spread over several shards: each shard counts
+ * down when its part is done, and the first exception is kept for the
+ * caller
+ */
+struct BatchCompletion {
+    latch done;
+    atomic<size_t> count{ 0 };
+    mutex lock;
+    exception_ptr error;
+
+    explicit BatchCompletion(ptrdiff_t parts) : done(parts) {}
+
+    void Fail(exception_ptr failure) {
+        lock_guard<mutex> guard(this->lock);
+        if (!this->error) {
+            this->error = failure;
+        }
+    }
+
+    size_t Wait() {
+        this->done.wait();
+        if (this->error) {
+            rethrow_exception(this->error);
+        }
+        return this->count.load();
+    }
+};
+
+}
+
+/**
+ * Start the shards and their workers
+ *
+ * @param shardCount Number of shards, 0 for one per hardware thread
+ * @param pinWorkers Pin each worker to its own CPU (Linux only), so its
+ *        shard stays in that core's caches
+ */
+ShardedHashTable::ShardedHashTable(size_t shardCount, bool pinWorkers) {
+    unsigned int cpus = max(1u, thread::hardware_concurrency());
+    this->shardCount = shardCount != 0 ? shardCount : cpus;
+    this->shards.reset(new Shard[this->shardCount]);
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        Shard& shard = this->shards[i];
+        shard.worker = thread(work, ref(shard));
+#ifdef __linux__
+        if (pinWorkers) {
+            cpu_set_t cpu;
+            CPU_ZERO(&cpu);
+            CPU_SET(i % cpus, &cpu);
+            pthread_setaffinity_np(shard.worker.native_handle(), sizeof(cpu), &cpu);
+        }
+#else
+        (void) pinWorkers;
+#endif
+    }
+}
+
+/**
+ * Destructor: every request already queued still runs, then the workers
+ * stop
+ */
+ShardedHashTable::~ShardedHashTable() {
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        Shard* shard = &this->shards[i];
+        this->post(i, [shard](HashTable&) {
+            shard->running = false;
+        });
+    }
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        this->shards[i].worker.join();
+    }
+}
+
+size_t ShardedHashTable::shardFor(string_view bidId) const {
+    // the high half, which HashTable uses least for slot positions
+    return (hashBidId(bidId) >> 32) % this->shardCount;
+}
+
+/**
+ * Append a request to a shard's queue and wake its worker. Safe from any
+ * thread.
+ */
+void ShardedHashTable::push(Shard& shard, Request* request) {
+    link(shard, request);
+    shard.pushes.fetch_add(1, memory_order_release);
+    shard.pushes.notify_one();
+}
+
+/**
+ * The lock-free part of a push: swing the head to the new request, then
+ * hang it off the old head. Between the two steps the request is queued
+ * but not yet reachable, which pop() reports as an empty queue.
+ */
+void ShardedHashTable::link(Shard& shard, Request* request) {
+    request->next.store(nullptr, memory_order_relaxed);
+    Request* previous = shard.head.exchange(request, memory_order_acq_rel);
+    previous->next.store(request, memory_order_release);
+}
+
+/**
+ * Take the oldest request off a shard's queue. Worker thread only.
+ *
+ * @return the request, nullptr if there is none (or the newest one is
+ *         still being linked)
+ */
+ShardedHashTable::Request* ShardedHashTable::pop(Shard& shard) {
+    Request* tail = shard.tail;
+    Request* next = tail->next.load(memory_order_acquire);
+    if (tail == &shard.stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        shard.tail = next;
+        tail = next;
+        next = next->next.load(memory_order_acquire);
+    }
+    if (next != nullptr) {
+        shard.tail = next;
+        return tail;
+    }
+    if (tail != shard.head.load(memory_order_acquire)) {
+        return nullptr;
+    }
+    // tail is the only request: put the stub behind it so it can be taken
+    link(shard, &shard.stub);
+    next = tail->next.load(memory_order_acquire);
+    if (next != nullptr) {
+        shard.tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+/**
+ * A shard's worker: run requests until told to stop, sleeping while the
+ * queue is empty
+ */
+void ShardedHashTable::work(Shard& shard) {
+    while (shard.running) {
+        // read before looking, so a push after the look changes it
+        uint32_t pushes = shard.pushes.load(memory_order_acquire);
+        Request* request = pop(shard);
+        if (request == nullptr) {
+            shard.pushes.wait(pushes, memory_order_acquire);
+            continue;
+        }
+        request->Run(shard.table);
+        delete request;
+        shard.size.store(shard.table.Size(), memory_order_relaxed);
+    }
+}
+
+/**
+ * Insert a bid; a bid with the same id replaces it
+ *
+ * @return a future for true if the id was new
+ */
+future<bool> ShardedHashTable::Insert(Bid bid) {
+    size_t shard = this->shardFor(bid.bidId);
+    return this->submit<bool>(shard, [bid = std::move(bid)](HashTable& table) mutable {
+        return table.Insert(std::move(bid));
+    });
+}
+
+/**
+ * Remove a bid
+ *
+ * @return a future for true if the bid was found and removed
+ */
+future<bool> ShardedHashTable::Remove(string bidId) {
+    size_t shard = this->shardFor(bidId);
+    return this->submit<bool>(shard, [bidId = std::move(bidId)](HashTable& table) {
+        return table.Remove(bidId);
+    });
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @return a future for a copy of the bid, an empty bid if not found
+ */
+future<Bid> ShardedHashTable::Search(string bidId) {
+    size_t shard = this->shardFor(bidId);
+    return this->submit<Bid>(shard, [bidId = std::move(bidId)](HashTable& table) {
+        const Bid* bid = table.Find(bidId);
+        return bid != nullptr ? *bid : Bid();
+    });
+}
+
+/**
+ * Insert a batch of bids with one request per shard, and wait for all of
+ * them
+ *
+ * @return the number of ids that were new
+ */
+size_t ShardedHashTable::InsertMany(vector<Bid> bids) {
+    vector<vector<Bid>> groups(this->shardCount);
+    for (Bid& bid : bids) {
+        groups[this->shardFor(bid.bidId)].push_back(std::move(bid));
+    }
+    ptrdiff_t parts = count_if(groups.begin(), groups.end(), [](const vector<Bid>& group) {
+        return !group.empty();
+    });
+
+    BatchCompletion completion(parts);
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        if (groups[i].empty()) {
+            continue;
+        }
+        this->post(i, [&completion, group = std::move(groups[i])](HashTable& table) mutable {
+            try {
+                table.Reserve(table.Size() + group.size());
+                size_t inserted = 0;
+                for (Bid& bid : group) {
+                    inserted += table.Insert(std::move(bid));
+                }
+                completion.count.fetch_add(inserted);
+            } catch (...) {
+                completion.Fail(current_exception());
+            }
+            completion.done.count_down();
+        });
+    }
+    return completion.Wait();
+}
+
+/**
+ * Look up a batch of ids with one request per shard, each run as one
+ * HashTable::SearchMany, and wait for all of them
+ *
+ * @param bidIds The ids to look up
+ * @param found Receives, at the same position as each id, a copy of its
+ *        bid or an empty bid
+ * @return the number of ids found
+ * @throw invalid_argument if found is shorter than bidIds
+ */
+size_t ShardedHashTable::SearchMany(span<const string> bidIds, span<Bid> found) {
+    if (found.size() < bidIds.size()) {
+        throw invalid_argument("ShardedHashTable::SearchMany: output shorter than input");
+    }
+    vector<vector<size_t>> groups(this->shardCount);
+    for (size_t i = 0; i < bidIds.size(); ++i) {
+        groups[this->shardFor(bidIds[i])].push_back(i);
+    }
+    ptrdiff_t parts = count_if(groups.begin(), groups.end(), [](const vector<size_t>& group) {
+        return !group.empty();
+    });
+
+    BatchCompletion completion(parts);
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        if (groups[i].empty()) {
+            continue;
+        }
+        this->post(i, [&completion, bidIds, found, positions = std::move(groups[i])](
+                HashTable& table) {
+            try {
+                vector<string_view> keys;
+                keys.reserve(positions.size());
+                for (size_t position : positions) {
+                    keys.push_back(bidIds[position]);
+                }
+                vector<const Bid*> bids(positions.size());
+                completion.count.fetch_add(table.SearchMany(keys, bids));
+                for (size_t k = 0; k < positions.size(); ++k) {
+                    found[positions[k]] = bids[k] != nullptr ? *bids[k] : Bid();
+                }
+            } catch (...) {
+                completion.Fail(current_exception());
+            }
+            completion.done.count_down();
+        });
+    }
+    return completion.Wait();
+}
+
+void ShardedHashTable::PrintAll() {
+    this->ForEach(displayBid);
+}
+
+/**
+ * @return the number of bids, as of the requests the workers have
+ *         finished
+ */
+size_t ShardedHashTable::Size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        total += this->shards[i].size.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * Size every shard for its share of a number of bids, and wait until
+ * they have
+ *
+ * @param count Number of bids expected in the whole table
+ */
+void ShardedHashTable::Reserve(size_t count) {
+    size_t share = count / this->shardCount + count / this->shardCount / 8 + 1;
+    vector<future<void>> reserved;
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        reserved.push_back(this->submit<void>(i, [share](HashTable& table) {
+            table.Reserve(share);
+        }));
+    }
+    for (future<void>& done : reserved) {
+        done.get();
+    }
+}
+
+size_t ShardedHashTable::ShardCount() const {
+    return this->shardCount;
+}
@@ -0,0 +1,167 @@
+//============================================================================
+// Name        : ShardedHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bid table split into shards, each owned by a worker thread
+//============================================================================
+
+#ifndef SHARDEDHASHTABLE_HPP_
+#define SHARDEDHASHTABLE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Bid.hpp"
+#include "HashTable.hpp"
+
+//============================================================================
+// Sharded Hash Table class definition
+//============================================================================
+
+/**
+ * A hash table of bids for many threads mixing inserts and lookups,
+ * without any lock or line of table memory shared between them.
+ *
+ * The bids are split by hash over a number of shards, one per core by
+ * default. Each shard is an ordinary HashTable that only its own worker
+ * thread ever touches. Callers do not access the tables at all: they
+ * push requests onto the shard's queue and the worker drains it, so the
+ * only memory callers and worker share is the queue itself, and shards
+ * share nothing.
+ *
+ * The queues are lock-free intrusive lists (Vyukov's multi-producer,
+ * single-consumer queue): a push is one atomic exchange. A worker with
+ * nothing to do sleeps on an atomic wait and is woken by the next push.
+ *
+ * Single operations return futures. The batched calls (InsertMany,
+ * SearchMany) send each shard one request covering all of its bids and
+ * complete when the last shard has finished, which amortizes the queue
+ * and the wakeup over the whole batch.
+ *
+ * Requests to one shard run in the order they were pushed. Requests to
+ * different shards are independent, so, for example, the futures of an
+ * Insert followed by a Search of another id can complete in either order.
+ */
+class ShardedHashTable {
+
+private:
+    // a queued operation; the worker runs it against its table and
+    // deletes it
+    struct Request {
+        std::atomic<Request*> next{ nullptr };
+
+        virtual ~Request() {}
+        virtual void Run(HashTable& table) = 0;
+    };
+
+    template<typename Call>
+    struct CallRequest : Request {
+        Call call;
+
+        explicit CallRequest(Call call) : call(std::move(call)) {}
+        void Run(HashTable& table) override { this->call(table); }
+    };
+
+    // the queue's permanent node, so it is never empty of nodes
+    struct StubRequest : Request {
+        void Run(HashTable&) override {}
+    };
+
+    struct Shard {
+        // written by callers
+        alignas(64) std::atomic<Request*> head;
+        std::atomic<uint32_t> pushes{ 0 };	// what a sleeping worker waits on
+
+        // the worker's own
+        alignas(64) Request* tail;
+        StubRequest stub;
+        HashTable table;
+        bool running = true;
+        std::atomic<size_t> size{ 0 };		// for Size(), published by the worker
+        std::thread worker;
+
+        Shard() : head(&stub), tail(&stub) {}
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardCount;
+
+    size_t shardFor(std::string_view bidId) const;
+    static void push(Shard& shard, Request* request);
+    static void link(Shard& shard, Request* request);
+    static Request* pop(Shard& shard);
+    static void work(Shard& shard);
+
+    template<typename Call>
+    void post(size_t shard, Call call);
+    template<typename Result, typename Call>
+    std::future<Result> submit(size_t shard, Call call);
+
+public:
+    explicit ShardedHashTable(size_t shardCount = 0, bool pinWorkers = false);
+    virtual ~ShardedHashTable();
+    ShardedHashTable(const ShardedHashTable&) = delete;
+    ShardedHashTable& operator=(const ShardedHashTable&) = delete;
+
+    std::future<bool> Insert(Bid bid);
+    std::future<bool> Remove(std::string bidId);
+    std::future<Bid> Search(std::string bidId);
+    size_t InsertMany(std::vector<Bid> bids);
+    size_t SearchMany(std::span<const std::string> bidIds, std::span<Bid> found);
+    template<typename Visitor>
+    void ForEach(Visitor visit);
+    void PrintAll();
+    size_t Size() const;
+    void Reserve(size_t count);
+    size_t ShardCount() const;
+};
+
+/**
+ * Queue a call to run on a shard's worker, without waiting for it
+ */
+template<typename Call>
+void ShardedHashTable::post(size_t shard, Call call) {
+    this->push(this->shards[shard], new CallRequest<Call>(std::move(call)));
+}
+
+/**
+ * Queue a call to run on a shard's worker
+ *
+ * @return a future for the call's result, or for what it threw
+ */
+template<typename Result, typename Call>
+std::future<Result> ShardedHashTable::submit(size_t shard, Call call) {
+    std::packaged_task<Result(HashTable&)> task(std::move(call));
+    std::future<Result> result = task.get_future();
+    this->post(shard, std::move(task));
+    return result;
+}
+
+/**
+ * Call visit(const Bid&) for every bid, one shard at a time, each on its
+ * own worker thread. Requests queued before the call are seen; the visit
+ * is not a snapshot across shards. The visitor must not call back into
+ * the table.
+ *
+ * @param visit Function or lambda to call with each bid
+ */
+template<typename Visitor>
+void ShardedHashTable::ForEach(Visitor visit) {
+    for (size_t i = 0; i < this->shardCount; ++i) {
+        this->submit<void>(i, [&visit](HashTable& table) {
+            table.ForEach(visit);
+        }).get();
+    }
+}
+
+#endif /* SHARDEDHASHTABLE_HPP_ */
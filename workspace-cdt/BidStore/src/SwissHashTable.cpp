@@ -0,0 +1,288 @@
+//============================================================================
+// Name        : SwissHashTable.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Open-addressing hash table for bids probed 16 slots at a time
+//============================================================================
+
+#include <algorithm>
+#include <bit>
+#include <new>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_SSE2 1
+#endif
+
+#include "SwissHashTable.hpp"
+
+using namespace std;
+
+namespace {
+
+// the low 7 bits of a hash go in the control byte, the rest pick the group
+inline int8_t fingerprintOf(uint64_t hash) {
+    return static_cast<int8_t>(hash & 0x7F);
+}
+
+}
+
+/**
+ * Compare the 16 control bytes of a group against one value
+ *
+ * @return a mask with bit i set where byte i equals the value
+ */
+uint32_t SwissHashTable::matchByte(const int8_t* group, int8_t value) {
+#ifdef SWISS_SSE2
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+        mask |= static_cast<uint32_t>(group[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * Smallest table that holds a number of bids below the 7/8 load limit
+ */
+size_t SwissHashTable::capacityFor(size_t count) {
+    return bit_ceil(max(GROUP_WIDTH, (count * 8 + 6) / 7));
+}
+
+/**
+ * Default constructor
+ */
+SwissHashTable::SwissHashTable() {
+    this->resize(GROUP_WIDTH);
+}
+
+/**
+ * Destructor
+ */
+SwissHashTable::~SwissHashTable() {
+    this->destroyBids();
+}
+
+void SwissHashTable::destroyBids() {
+    for (size_t position = 0; position < this->capacity; ++position) {
+        if (this->control[position] >= 0) {
+            this->slots[position].bid.~Bid();
+        }
+    }
+}
+
+/**
+ * Locate the slot of a bid id
+ *
+ * @return the slot position, or capacity if the id is not present
+ */
+size_t SwissHashTable::findSlot(string_view bidId, uint64_t hash) const {
+    size_t groupMask = this->capacity / GROUP_WIDTH - 1;
+    size_t group = (hash >> 7) & groupMask;
+    int8_t fingerprint = fingerprintOf(hash);
+
+    for (size_t step = 1; ; ++step) {
+        const int8_t* bytes = &this->control[group * GROUP_WIDTH];
+        for (uint32_t matches = matchByte(bytes, fingerprint); matches != 0;
+                matches &= matches - 1) {
+            size_t position = group * GROUP_WIDTH + countr_zero(matches);
+            if (this->slots[position].bid.bidId == bidId) {
+                return position;
+            }
+        }
+        // an insert would have used this empty slot rather than go on
+        if (matchByte(bytes, EMPTY) != 0) {
+            return this->capacity;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * The first empty or deleted slot on a hash's probe sequence. The load
+ * limit keeps some slot empty, so there always is one.
+ */
+size_t SwissHashTable::findFreeSlot(uint64_t hash) const {
+    size_t groupMask = this->capacity / GROUP_WIDTH - 1;
+    size_t group = (hash >> 7) & groupMask;
+
+    for (size_t step = 1; ; ++step) {
+        const int8_t* bytes = &this->control[group * GROUP_WIDTH];
+        uint32_t free = matchByte(bytes, EMPTY) | matchByte(bytes, DELETED);
+        if (free != 0) {
+            return group * GROUP_WIDTH + countr_zero(free);
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+/**
+ * Move every bid into new arrays of a given capacity, which also clears
+ * out the deleted slots
+ *
+ * @param newCapacity A power of two of at least GROUP_WIDTH
+ */
+void SwissHashTable::resize(size_t newCapacity) {
+    unique_ptr<int8_t[]> oldControl = std::move(this->control);
+    unique_ptr<Slot[]> oldSlots = std::move(this->slots);
+    size_t oldCapacity = this->capacity;
+
+    this->control.reset(new int8_t[newCapacity]);
+    fill_n(this->control.get(), newCapacity, EMPTY);
+    this->slots.reset(new Slot[newCapacity]);
+    this->capacity = newCapacity;
+    this->growthLeft = newCapacity - newCapacity / 8 - this->bidCount;
+    this->deletedCount = 0;
+
+    for (size_t position = 0; position < oldCapacity; ++position) {
+        if (oldControl[position] >= 0) {
+            Bid& bid = oldSlots[position].bid;
+            uint64_t hash = hashBidId(bid.bidId);
+            size_t target = this->findFreeSlot(hash);
+            this->control[target] = fingerprintOf(hash);
+            ::new (&this->slots[target].bid) Bid(std::move(bid));
+            bid.~Bid();
+        }
+    }
+}
+
+/**
+ * Insert a bid, replacing any bid with the same id
+ *
+ * @param bid The bid to insert
+ * @return true if the id was new
+ */
+bool SwissHashTable::Insert(const Bid& bid) {
+    return this->Insert(Bid(bid));
+}
+
+bool SwissHashTable::Insert(Bid&& bid) {
+    uint64_t hash = hashBidId(bid.bidId);
+    size_t position = this->findSlot(bid.bidId, hash);
+    if (position != this->capacity) {
+        this->slots[position].bid = std::move(bid);
+        return false;
+    }
+
+    if (this->growthLeft == 0) {
+        // mostly deleted slots: rehash at the same size to reclaim them
+        size_t live = this->bidCount + 1;
+        this->resize(live <= this->capacity / 2 ? this->capacity : this->capacity * 2);
+    }
+    position = this->findFreeSlot(hash);
+    if (this->control[position] == EMPTY) {
+        --this->growthLeft;
+    } else {
+        --this->deletedCount;
+    }
+    this->control[position] = fingerprintOf(hash);
+    ::new (&this->slots[position].bid) Bid(std::move(bid));
+    ++this->bidCount;
+    return true;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ * @return true if the bid was found and removed
+ */
+bool SwissHashTable::Remove(string_view bidId) {
+    size_t position = this->findSlot(bidId, hashBidId(bidId));
+    if (position == this->capacity) {
+        return false;
+    }
+
+    this->slots[position].bid.~Bid();
+    --this->bidCount;
+    // a group that still has an empty slot has never been full since the
+    // last rehash, so no probe went past it and nothing needs the marker
+    const int8_t* group = &this->control[position / GROUP_WIDTH * GROUP_WIDTH];
+    if (matchByte(group, EMPTY) != 0) {
+        this->control[position] = EMPTY;
+        ++this->growthLeft;
+    } else {
+        this->control[position] = DELETED;
+        // compact once markers are a quarter of the occupied slots, which
+        // spreads the rehash over at least a third as many removals as
+        // there are bids
+        if (++this->deletedCount * 3 > this->bidCount && this->deletedCount >= GROUP_WIDTH) {
+            this->resize(this->capacity);
+        }
+    }
+    return true;
+}
+
+/**
+ * Find the bid with an id without copying it
+ *
+ * @return pointer to the bid, nullptr if not found; valid until the next
+ *         Insert or Remove
+ */
+const Bid* SwissHashTable::Find(string_view bidId) const {
+    size_t position = this->findSlot(bidId, hashBidId(bidId));
+    return position != this->capacity ? &this->slots[position].bid : nullptr;
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ * @return a copy of the bid, an empty bid if not found
+ */
+Bid SwissHashTable::Search(const string& bidId) const {
+    const Bid* bid = this->Find(bidId);
+    return bid != nullptr ? *bid : Bid();
+}
+
+void SwissHashTable::PrintAll() const {
+    this->ForEach(displayBid);
+}
+
+size_t SwissHashTable::Size() const {
+    return this->bidCount;
+}
+
+/**
+ * Size the table for a number of bids up front, so loading them never
+ * rehashes
+ *
+ * @param count Number of bids expected
+ */
+void SwissHashTable::Reserve(size_t count) {
+    size_t needed = capacityFor(count);
+    if (needed > this->capacity) {
+        this->resize(needed);
+    }
+}
+
+/**
+ * Rehash at the smallest size that holds the bids below the load limit,
+ * which also clears every deleted slot
+ */
+void SwissHashTable::ShrinkToFit() {
+    size_t needed = capacityFor(this->bidCount);
+    if (needed < this->capacity || this->deletedCount != 0) {
+        this->resize(min(needed, this->capacity));
+    }
+}
+
+size_t SwissHashTable::Capacity() const {
+    return this->capacity;
+}
+
+float SwissHashTable::LoadFactor() const {
+    return static_cast<float>(this->bidCount) / this->capacity;
+}
+
+/**
+ * @return the number of slots marked deleted, which probes still pass
+ *         over, until the next rehash
+ */
+size_t SwissHashTable::DeletedSlots() const {
+    return this->deletedCount;
+}
@@ -0,0 +1,115 @@
+//============================================================================
+// Name        : SwissHashTable.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Open-addressing hash table for bids probed 16 slots at a time
+//============================================================================
+
+#ifndef SWISSHASHTABLE_HPP_
+#define SWISSHASHTABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Bid.hpp"
+#include "HashFunctions.hpp"
+
+//============================================================================
+// Swiss Hash Table class definition
+//============================================================================
+
+/**
+ * A hash table of bids in the style of Abseil's Swiss tables.
+ *
+ * Bids are stored in place in a flat slot array. Alongside it runs an
+ * array of control bytes, one per slot: empty, deleted, or 7 bits of the
+ * bid's hash. Slots form aligned groups of 16, and a lookup compares its
+ * 7 bits against a whole group's control bytes in one SSE2 instruction
+ * (a plain loop where SSE2 is unavailable). Bid ids are only compared on
+ * a control byte match, about one slot in 128 otherwise, and the probe
+ * stops at the first group with an empty slot, so a miss usually costs a
+ * single group compare.
+ *
+ * Groups are probed in triangular order, which visits every group of a
+ * power-of-two table. The table grows at 7/8 full; deleted slots count
+ * toward that until the next rehash, except where the group still has an
+ * empty slot, in which case no probe can have passed it and the slot is
+ * simply emptied.
+ *
+ * The deleted markers that remain keep groups full, so misses probe on
+ * past them. Once they make up a quarter of the occupied slots, Remove
+ * rehashes the table at its current size, which clears them all; under
+ * steady removing and inserting, probe lengths therefore stay near those
+ * of a freshly built table. ShrinkToFit rehashes at the smallest size
+ * that holds the bids.
+ */
+class SwissHashTable {
+
+private:
+    static constexpr size_t GROUP_WIDTH = 16;
+    static constexpr int8_t EMPTY = -128;
+    static constexpr int8_t DELETED = -2;
+
+    // storage for a bid, constructed only while its control byte is full
+    union Slot {
+        Bid bid;
+
+        Slot() {}
+        ~Slot() {}
+    };
+
+    std::unique_ptr<int8_t[]> control;
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity = 0;			// a power of two, at least GROUP_WIDTH
+    size_t bidCount = 0;
+    size_t growthLeft = 0;			// empty slots that may still be filled
+    size_t deletedCount = 0;		// slots marked deleted since the last rehash
+
+    static uint32_t matchByte(const int8_t* group, int8_t value);
+    static size_t capacityFor(size_t count);
+    size_t findSlot(std::string_view bidId, uint64_t hash) const;
+    size_t findFreeSlot(uint64_t hash) const;
+    void resize(size_t newCapacity);
+    void destroyBids();
+
+public:
+    SwissHashTable();
+    virtual ~SwissHashTable();
+    SwissHashTable(const SwissHashTable&) = delete;
+    SwissHashTable& operator=(const SwissHashTable&) = delete;
+    bool Insert(const Bid& bid);
+    bool Insert(Bid&& bid);
+    bool Remove(std::string_view bidId);
+    const Bid* Find(std::string_view bidId) const;
+    Bid Search(const std::string& bidId) const;
+    template<typename Visitor>
+    void ForEach(Visitor visit) const;
+    void PrintAll() const;
+    size_t Size() const;
+    void Reserve(size_t count);
+    void ShrinkToFit();
+    size_t Capacity() const;
+    float LoadFactor() const;
+    size_t DeletedSlots() const;
+};
+
+/**
+ * Call visit(const Bid&) for every bid, in slot order
+ *
+ * @param visit Function or lambda to call with each bid
+ */
+template<typename Visitor>
+void SwissHashTable::ForEach(Visitor visit) const {
+    for (size_t position = 0; position < this->capacity; ++position) {
+        if (this->control[position] >= 0) {
+            visit(this->slots[position].bid);
+        }
+    }
+}
+
+#endif /* SWISSHASHTABLE_HPP_ */
@@ -0,0 +1,119 @@
+//============================================================================
+// Name        : TableStats.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Occupancy statistics and operation counters for hash tables
+//============================================================================
+
+#include <iomanip>
+#include <string>
+
+#include "TableStats.hpp"
+
+using namespace std;
+
+/**
+ * Count one entry with the given probe length
+ */
+void TableStats::AddProbe(size_t length) {
+    if (length >= this->probeHistogram.size()) {
+        this->probeHistogram.resize(length + 1, 0);
+    }
+    ++this->probeHistogram[length];
+}
+
+/**
+ * Derive the summary figures from the histogram and keep the most loaded
+ * buckets
+ *
+ * @param bucketLoads Candidate buckets and the entries hashed to each
+ * @param hotCount How many of the most loaded to keep
+ */
+void TableStats::Finish(vector<pair<size_t, size_t>> bucketLoads, size_t hotCount) {
+    this->loadFactor = this->buckets == 0 ? 0.0
+            : static_cast<double>(this->entries) / this->buckets;
+
+    size_t total = 0, sum = 0;
+    for (size_t length = 0; length < this->probeHistogram.size(); ++length) {
+        total += this->probeHistogram[length];
+        sum += length * this->probeHistogram[length];
+        if (this->probeHistogram[length] != 0) {
+            this->maxProbe = length;
+        }
+    }
+    this->meanProbe = total == 0 ? 0.0 : static_cast<double>(sum) / total;
+    size_t seen = 0;
+    for (size_t length = 0; length < this->probeHistogram.size(); ++length) {
+        seen += this->probeHistogram[length];
+        if (seen * 100 >= total * 99) {
+            this->p99Probe = length;
+            break;
+        }
+    }
+
+    hotCount = min(hotCount, bucketLoads.size());
+    partial_sort(bucketLoads.begin(), bucketLoads.begin() + hotCount, bucketLoads.end(),
+            [](const pair<size_t, size_t>& a, const pair<size_t, size_t>& b) {
+                return a.second != b.second ? a.second > b.second : a.first < b.first;
+            });
+    bucketLoads.resize(hotCount);
+    this->hotBuckets = std::move(bucketLoads);
+}
+
+/**
+ * Print a stats snapshot as a short report
+ */
+void printTableStats(ostream& out, const TableStats& stats) {
+    out << "entries:       " << stats.entries << endl;
+    out << "buckets:       " << stats.buckets << endl;
+    out << fixed << setprecision(3);
+    out << "load factor:   " << stats.loadFactor << endl;
+    out << "empty buckets: " << stats.emptyBuckets;
+    if (stats.buckets != 0) {
+        out << " (" << setprecision(1) << 100.0 * stats.emptyBuckets / stats.buckets << "%)";
+    }
+    out << endl;
+    out << "probe length:  max " << stats.maxProbe << ", mean " << setprecision(3)
+            << stats.meanProbe << ", p99 " << stats.p99Probe << endl;
+    out << "memory:        " << stats.memoryBytes << " bytes";
+    if (stats.entries != 0) {
+        out << " (" << setprecision(1)
+                << static_cast<double>(stats.memoryBytes) / stats.entries << " per entry)";
+    }
+    out << endl;
+
+    out << "probe length histogram:" << endl;
+    size_t total = max<size_t>(stats.entries, 1);
+    for (size_t length = 0; length < stats.probeHistogram.size(); ++length) {
+        size_t count = stats.probeHistogram[length];
+        if (count == 0) {
+            continue;
+        }
+        out << setw(6) << length << setw(10) << count << setw(8) << setprecision(2)
+                << 100.0 * count / total << "%  "
+                << string(max<size_t>(count * 50 / total, 1), '#') << endl;
+    }
+
+    if (!stats.hotBuckets.empty()) {
+        out << "most loaded buckets:" << endl;
+        for (const pair<size_t, size_t>& bucket : stats.hotBuckets) {
+            out << setw(12) << bucket.first << setw(6) << bucket.second << endl;
+        }
+    }
+
+    if (stats.counts.enabled) {
+        const OperationCounts& counts = stats.counts;
+        uint64_t operations = counts.lookups + counts.inserts + counts.removes;
+        out << "operations:    " << counts.lookups << " lookups (" << counts.hits
+                << " hits), " << counts.inserts << " inserts, " << counts.removes
+                << " removes, " << counts.rehashes << " rehashes" << endl;
+        out << "probes:        " << counts.probes << " (" << setprecision(2)
+                << (operations == 0 ? 0.0 : static_cast<double>(counts.probes) / operations)
+                << " per operation)" << endl;
+    } else {
+        out << "operations:    not counted (build with BIDSTORE_STATS)" << endl;
+    }
+    out.unsetf(ios::floatfield);
+    out << setprecision(6);
+}
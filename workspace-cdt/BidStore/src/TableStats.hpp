@@ -0,0 +1,129 @@
+//============================================================================
+// Name        : TableStats.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Occupancy statistics and operation counters for hash tables
+//============================================================================
+
+#ifndef TABLESTATS_HPP_
+#define TABLESTATS_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+//============================================================================
+// Operation counters
+//============================================================================
+
+/**
+ * Totals of the operations a table has served since it was built
+ */
+struct OperationCounts {
+    bool enabled = false;			// false when the counters are compiled out
+    uint64_t lookups = 0;			// HashMap counts the key check of each insert too
+    uint64_t hits = 0;
+    uint64_t probes = 0;			// slots (HashMap, every operation) or chain nodes (lookups)
+    uint64_t inserts = 0;
+    uint64_t removes = 0;
+    uint64_t rehashes = 0;
+};
+
+#ifdef BIDSTORE_STATS
+
+/**
+ * Per-operation counters, enabled by building with BIDSTORE_STATS.
+ * Relaxed atomics, so tables read under a shared lock can still count;
+ * lookups from many threads do contend on them, which is why they are
+ * off by default.
+ */
+class OperationCounters {
+
+private:
+    std::atomic<uint64_t> lookups{ 0 };
+    std::atomic<uint64_t> hits{ 0 };
+    std::atomic<uint64_t> probes{ 0 };
+    std::atomic<uint64_t> inserts{ 0 };
+    std::atomic<uint64_t> removes{ 0 };
+    std::atomic<uint64_t> rehashes{ 0 };
+
+public:
+    void Lookup(bool hit) {
+        this->lookups.fetch_add(1, std::memory_order_relaxed);
+        this->hits.fetch_add(hit, std::memory_order_relaxed);
+    }
+    void Probe(uint64_t inspected) { this->probes.fetch_add(inspected, std::memory_order_relaxed); }
+    void Insert() { this->inserts.fetch_add(1, std::memory_order_relaxed); }
+    void Remove() { this->removes.fetch_add(1, std::memory_order_relaxed); }
+    void Rehash() { this->rehashes.fetch_add(1, std::memory_order_relaxed); }
+
+    OperationCounts Snapshot() const {
+        OperationCounts counts;
+        counts.enabled = true;
+        counts.lookups = this->lookups.load(std::memory_order_relaxed);
+        counts.hits = this->hits.load(std::memory_order_relaxed);
+        counts.probes = this->probes.load(std::memory_order_relaxed);
+        counts.inserts = this->inserts.load(std::memory_order_relaxed);
+        counts.removes = this->removes.load(std::memory_order_relaxed);
+        counts.rehashes = this->rehashes.load(std::memory_order_relaxed);
+        return counts;
+    }
+};
+
+#else
+
+/**
+ * The counters compiled out: an empty member whose calls inline to
+ * nothing
+ */
+class OperationCounters {
+
+public:
+    void Lookup(bool) {}
+    void Probe(uint64_t) {}
+    void Insert() {}
+    void Remove() {}
+    void Rehash() {}
+
+    OperationCounts Snapshot() const {
+        return OperationCounts();
+    }
+};
+
+#endif
+
+//============================================================================
+// Occupancy statistics
+//============================================================================
+
+/**
+ * A snapshot of how a table's entries sit in its buckets. A bucket is a
+ * slot of an open-addressing table or a chain of a chained one; an
+ * entry's probe length is the number of slots (or chain nodes) a lookup
+ * passes before reaching it, 0 when it sits first.
+ */
+struct TableStats {
+    size_t entries = 0;
+    size_t buckets = 0;
+    double loadFactor = 0.0;
+    size_t emptyBuckets = 0;
+    std::vector<size_t> probeHistogram;	// entries by probe length
+    size_t maxProbe = 0;
+    double meanProbe = 0.0;
+    size_t p99Probe = 0;
+    size_t memoryBytes = 0;				// the table's own arrays and nodes
+    std::vector<std::pair<size_t, size_t>> hotBuckets;	// bucket, entries hashed to it
+    OperationCounts counts;
+
+    void AddProbe(size_t length);
+    void Finish(std::vector<std::pair<size_t, size_t>> bucketLoads, size_t hotCount);
+};
+
+void printTableStats(std::ostream& out, const TableStats& stats);
+
+#endif /* TABLESTATS_HPP_ */
@@ -0,0 +1,239 @@
+//============================================================================
+// Name        : Benchmark.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Timing, latency percentiles and reporting for benchmarks
+//============================================================================
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+#include "Benchmark.hpp"
+#include "CSVparser.hpp"
+
+using namespace std;
+
+//============================================================================
+// LatencyRecorder
+//============================================================================
+
+void LatencyRecorder::Reserve(size_t count) {
+    this->samples.reserve(count);
+}
+
+void LatencyRecorder::Add(uint64_t nanoseconds) {
+    this->samples.push_back(nanoseconds);
+}
+
+size_t LatencyRecorder::Count() const {
+    return this->samples.size();
+}
+
+uint64_t LatencyRecorder::Total() const {
+    return accumulate(this->samples.begin(), this->samples.end(), uint64_t(0));
+}
+
+/**
+ * Fill in the percentile fields of a result (nearest rank). ns/op is
+ * left alone when the caller already set it from an untimed-per-op pass.
+ *
+ * @param result The result to complete
+ */
+void LatencyRecorder::Summarize(BenchmarkResult& result) {
+    if (this->samples.empty()) {
+        if (result.opsPerSecond == 0.0 && result.nsPerOp > 0.0) {
+            result.opsPerSecond = 1e9 / result.nsPerOp * result.threads;
+        }
+        return;
+    }
+
+    sort(this->samples.begin(), this->samples.end());
+
+    auto percentile = [this](double fraction) {
+        size_t rank = static_cast<size_t>(fraction * this->samples.size());
+        return static_cast<double>(this->samples[min(rank, this->samples.size() - 1)]);
+    };
+
+    result.hasLatencies = true;
+    result.p50 = percentile(0.50);
+    result.p90 = percentile(0.90);
+    result.p99 = percentile(0.99);
+    result.p999 = percentile(0.999);
+    result.max = static_cast<double>(this->samples.back());
+
+    if (result.ops == 0) {
+        result.ops = this->samples.size();
+    }
+    if (result.nsPerOp == 0.0) {
+        result.nsPerOp = static_cast<double>(this->Total()) / this->samples.size();
+    }
+    if (result.opsPerSecond == 0.0 && result.nsPerOp > 0.0) {
+        result.opsPerSecond = 1e9 / result.nsPerOp * result.threads;
+    }
+}
+
+//============================================================================
+// BenchmarkReport
+//============================================================================
+
+BenchmarkReport::BenchmarkReport(string suite) : suite(std::move(suite)) {
+}
+
+void BenchmarkReport::Add(const BenchmarkResult& result) {
+    this->results.push_back(result);
+}
+
+/**
+ * Print the results as an aligned text table
+ */
+void BenchmarkReport::PrintTable(ostream& out) const {
+    out << left << setw(22) << "container" << setw(14) << "operation"
+            << right << setw(10) << "size" << setw(8) << "threads"
+            << setw(12) << "ns/op" << setw(10) << "p50" << setw(10) << "p99"
+            << setw(10) << "p99.9" << setw(12) << "max" << endl;
+
+    for (const BenchmarkResult& result : this->results) {
+        out << left << setw(22) << result.container << setw(14)
+                << result.operation << right << setw(10) << result.size
+                << setw(8) << result.threads << fixed << setprecision(1)
+                << setw(12) << result.nsPerOp << setprecision(0);
+        if (result.hasLatencies) {
+            out << setw(10) << result.p50 << setw(10) << result.p99
+                    << setw(10) << result.p999 << setw(12) << result.max;
+        } else {
+            out << setw(10) << "-" << setw(10) << "-" << setw(10) << "-"
+                    << setw(12) << "-";
+        }
+        out << endl;
+    }
+    out.unsetf(ios::floatfield);
+}
+
+/**
+ * Write the results as JSON, one object per result, so runs can be
+ * compared by scripts
+ */
+void BenchmarkReport::WriteJson(ostream& out) const {
+    out << "{\n  \"suite\": \"" << this->suite << "\",\n  \"results\": [";
+    for (size_t i = 0; i < this->results.size(); ++i) {
+        const BenchmarkResult& result = this->results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"container\": \""
+                << result.container << "\", \"operation\": \""
+                << result.operation << "\", \"size\": " << result.size
+                << ", \"threads\": " << result.threads << ", \"ops\": "
+                << result.ops << fixed << setprecision(2)
+                << ", \"ns_per_op\": " << result.nsPerOp
+                << ", \"ops_per_second\": " << result.opsPerSecond;
+        if (result.hasLatencies) {
+            out << ", \"p50_ns\": " << result.p50 << ", \"p90_ns\": "
+                    << result.p90 << ", \"p99_ns\": " << result.p99
+                    << ", \"p999_ns\": " << result.p999 << ", \"max_ns\": "
+                    << result.max << "}";
+        } else {
+            out << ", \"p50_ns\": null, \"p90_ns\": null, \"p99_ns\": null"
+                    << ", \"p999_ns\": null, \"max_ns\": null}";
+        }
+        out.unsetf(ios::floatfield);
+    }
+    out << "\n  ]\n}\n";
+}
+
+/**
+ * Write the JSON report to a file
+ *
+ * @return false if the file could not be written
+ */
+bool BenchmarkReport::WriteJson(const string& path) const {
+    ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    this->WriteJson(file);
+    return file.good();
+}
+
+//============================================================================
+// Datasets
+//============================================================================
+
+/**
+ * Parse a comma separated list of sizes, e.g. "1000,10000,100000"
+ */
+vector<size_t> parseSizes(const string& text) {
+    vector<size_t> sizes;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) {
+            sizes.push_back(stoull(item));
+        }
+    }
+    return sizes;
+}
+
+/**
+ * Read every bid of an eBid CSV file
+ */
+vector<Bid> loadBidsFromCsv(const string& csvPath) {
+    vector<Bid> bids;
+    csv::Parser file = csv::Parser(csvPath);
+    bids.reserve(file.rowCount());
+    for (unsigned int i = 0; i < file.rowCount(); i++) {
+        bids.push_back(bidFromRow(file[i]));
+    }
+    return bids;
+}
+
+/**
+ * Build bids shaped like the eBid files with the synthetic generator. Ids
+ * are even so that odd ids make guaranteed misses.
+ *
+ * @param count Number of bids
+ * @param seed Seed for the id order and the field values
+ * @param ids Order the ids are generated (and inserted) in
+ */
+vector<Bid> makeBids(size_t count, uint64_t seed, IdDistribution ids) {
+    GeneratorOptions options;
+    options.rows = count;
+    options.seed = seed;
+    options.ids = ids;
+    options.firstId = 100000;
+    options.idStep = 2;
+    options.clusterSpread = 1;
+    return BidGenerator(options).MakeBids();
+}
+
+/**
+ * Build ids that are not in the dataset, for miss lookups
+ *
+ * @param bids The dataset; generated ids are checked against it
+ * @param count Number of missing ids
+ */
+vector<string> makeMissingIds(const vector<Bid>& bids, size_t count,
+        uint64_t seed) {
+    unordered_set<string> present;
+    present.reserve(bids.size());
+    for (const Bid& bid : bids) {
+        present.insert(bid.bidId);
+    }
+
+    mt19937_64 random(seed);
+    size_t range = max<size_t>(bids.size(), 1);
+
+    vector<string> ids;
+    ids.reserve(count);
+    while (ids.size() < count) {
+        string id = to_string(100000 + 2 * (random() % range) + 1);
+        if (present.count(id) == 0) {
+            ids.push_back(std::move(id));
+        }
+    }
+    return ids;
+}
@@ -0,0 +1,103 @@
+//============================================================================
+// Name        : Benchmark.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Timing, latency percentiles and reporting for benchmarks
+//============================================================================
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+#include "BidGenerator.hpp"
+
+/**
+ * Monotonic time in nanoseconds
+ */
+inline uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Keep the compiler from optimizing a benchmarked result away
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * One row of a benchmark report: a timed operation on one container at
+ * one data size. Latencies are in nanoseconds.
+ */
+struct BenchmarkResult {
+    std::string container;
+    std::string operation;
+    size_t size = 0;			// bids in the container
+    size_t ops = 0;				// operations timed
+    unsigned int threads = 1;
+    double nsPerOp = 0.0;
+    double opsPerSecond = 0.0;
+    bool hasLatencies = false;	// false when ops were only timed in bulk
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double p999 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * Collects per-operation latencies and turns them into percentiles
+ */
+class LatencyRecorder {
+
+private:
+    std::vector<uint64_t> samples;
+
+public:
+    void Reserve(size_t count);
+    void Add(uint64_t nanoseconds);
+    size_t Count() const;
+    uint64_t Total() const;
+    void Summarize(BenchmarkResult& result);
+};
+
+/**
+ * Accumulates results, prints them as a table and writes them as JSON
+ */
+class BenchmarkReport {
+
+private:
+    std::string suite;
+    std::vector<BenchmarkResult> results;
+
+public:
+    explicit BenchmarkReport(std::string suite);
+    void Add(const BenchmarkResult& result);
+    void PrintTable(std::ostream& out) const;
+    void WriteJson(std::ostream& out) const;
+    bool WriteJson(const std::string& path) const;
+};
+
+std::vector<size_t> parseSizes(const std::string& text);
+std::vector<Bid> loadBidsFromCsv(const std::string& csvPath);
+std::vector<Bid> makeBids(size_t count, uint64_t seed,
+        IdDistribution ids = IdDistribution::Shuffled);
+std::vector<std::string> makeMissingIds(const std::vector<Bid>& bids,
+        size_t count, uint64_t seed);
+
+#endif /* BENCHMARK_HPP_ */
@@ -0,0 +1,104 @@
+//============================================================================
+// Name        : BidGen.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Writes synthetic eBid CSV files for scale testing
+//============================================================================
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "BidGenerator.hpp"
+
+using namespace std;
+
+void usage(const char* program) {
+    cerr << "usage: " << program << " [--rows N] [--out file|-] [--seed N]\n"
+            << "    [--ids sequential|shuffled|clustered] [--first-id N]"
+            << " [--id-step N]\n"
+            << "    [--cluster-size N] [--cluster-spread N]\n"
+            << "    [--funds N] [--fund-skew S]\n"
+            << "    [--titles uniform|lognormal] [--title-min N] [--title-max N]\n"
+            << "    [--quoted FRACTION]" << endl;
+}
+
+/**
+ * The one and only main() method
+ */
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+    string outPath = "-";
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                return 1;
+            }
+            string value = argv[++i];
+            if (arg == "--rows") {
+                options.rows = stoull(value);
+            } else if (arg == "--out") {
+                outPath = value;
+            } else if (arg == "--seed") {
+                options.seed = stoull(value);
+            } else if (arg == "--ids") {
+                if (!parseIdDistribution(value, options.ids)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+            } else if (arg == "--first-id") {
+                options.firstId = static_cast<uint32_t>(stoul(value));
+            } else if (arg == "--id-step") {
+                options.idStep = static_cast<uint32_t>(stoul(value));
+            } else if (arg == "--cluster-size") {
+                options.clusterSize = static_cast<uint32_t>(stoul(value));
+            } else if (arg == "--cluster-spread") {
+                options.clusterSpread = static_cast<uint32_t>(stoul(value));
+            } else if (arg == "--funds") {
+                options.funds = static_cast<uint32_t>(stoul(value));
+            } else if (arg == "--fund-skew") {
+                options.fundSkew = stod(value);
+            } else if (arg == "--titles") {
+                if (!parseTitleLength(value, options.titleLength)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+            } else if (arg == "--title-min") {
+                options.titleMin = static_cast<uint32_t>(stoul(value));
+            } else if (arg == "--title-max") {
+                options.titleMax = static_cast<uint32_t>(stoul(value));
+            } else if (arg == "--quoted") {
+                options.quotedRatio = stod(value);
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+
+        BidGenerator generator(options);
+        if (outPath == "-") {
+            generator.WriteCsv(cout);
+        } else {
+            ofstream file(outPath, ios::binary);
+            if (!file.is_open()) {
+                cerr << "could not open " << outPath << endl;
+                return 1;
+            }
+            generator.WriteCsv(file);
+            if (!file.good()) {
+                cerr << "could not write " << outPath << endl;
+                return 1;
+            }
+        }
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
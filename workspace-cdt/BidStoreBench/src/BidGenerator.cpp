@@ -0,0 +1,346 @@
+//============================================================================
+// Name        : BidGenerator.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Synthetic eBid monthly sales data for scale testing
+//============================================================================
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "BidGenerator.hpp"
+
+using namespace std;
+
+const char* const EBID_HEADER = "ArticleTitle,ArticleID,Department,CloseDate,"
+        "WinningBid,InventoryID,VehicleID,ReceiptNumber,Fund";
+
+namespace {
+
+const char* const FUND_NAMES[] = { "General Fund", "Enterprise",
+        "Special Revenue", "Internal Service", "Capital Projects",
+        "Debt Service", "Trust", "Agency" };
+
+const char* const DEPARTMENTS[] = { "Public Works", "Police", "Fire",
+        "Parks and Recreation", "Information Technology", "Transportation" };
+
+const char* const WORDS[] = { "Hood", "Tractor", "Ford", "Pickup", "Desk",
+        "Chair", "Laptop", "Trailer", "Mower", "Radio", "Cabinet", "Sedan",
+        "Monitor", "Generator", "Ladder", "Bicycle" };
+
+/**
+ * splitmix64 finalizer, used as a counter-based random number generator
+ */
+inline uint64_t mix64(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// independent random streams per row and field
+enum Field {
+    TITLE_LENGTH, TITLE_WORDS, TITLE_QUOTED, DEPARTMENT, CLOSE_DATE, AMOUNT,
+    VEHICLE, FUND
+};
+
+}
+
+//============================================================================
+// BidGenerator
+//============================================================================
+
+/**
+ * Validate the options and precompute the fund distribution
+ */
+BidGenerator::BidGenerator(const GeneratorOptions& options)
+        : options(options) {
+    if (options.rows == 0 || options.idStep == 0 || options.funds == 0
+            || options.clusterSize == 0 || options.clusterSpread == 0
+            || options.titleMin > options.titleMax) {
+        throw invalid_argument("BidGenerator: invalid options");
+    }
+
+    // the largest id any distribution can produce must fit CompactBid
+    uint64_t span = options.rows;
+    if (options.ids == IdDistribution::Clustered) {
+        uint64_t clusters = (options.rows + options.clusterSize - 1) / options.clusterSize;
+        span = clusters * options.clusterSize * options.clusterSpread;
+    }
+    if (options.firstId + (span - 1) * options.idStep > numeric_limits<uint32_t>::max()) {
+        throw invalid_argument("BidGenerator: ids do not fit in 32 bits");
+    }
+
+    double total = 0.0;
+    for (uint32_t fund = 0; fund < options.funds; ++fund) {
+        total += 1.0 / pow(fund + 1.0, options.fundSkew);
+        this->fundCdf.push_back(total);
+        if (fund < sizeof(FUND_NAMES) / sizeof(FUND_NAMES[0])) {
+            this->fundNames.push_back(FUND_NAMES[fund]);
+        } else {
+            this->fundNames.push_back("Fund " + to_string(fund + 1));
+        }
+    }
+    for (double& weight : this->fundCdf) {
+        weight /= total;
+    }
+}
+
+/**
+ * Bijective shuffle of [0, domain): a 4-round Feistel network over the
+ * smallest even power of two covering the domain, with cycle walking for
+ * values that fall outside it
+ *
+ * @param index Value to permute, less than domain
+ * @param salt Distinguishes permutations used for different purposes
+ */
+uint64_t BidGenerator::permute(uint64_t index, uint64_t domain, uint64_t salt) const {
+    if (domain <= 2) {
+        return index;
+    }
+
+    unsigned int bits = static_cast<unsigned int>(bit_width(domain - 1));
+    bits += bits & 1;
+    unsigned int half = bits / 2;
+    uint64_t mask = (uint64_t(1) << half) - 1;
+
+    uint64_t value = index;
+    do {
+        uint64_t left = value >> half;
+        uint64_t right = value & mask;
+        for (uint64_t round = 0; round < 4; ++round) {
+            uint64_t next = left ^ (mix64(right ^ this->options.seed * 31
+                    ^ (salt << 56) ^ (round << 48)) & mask);
+            left = right;
+            right = next;
+        }
+        value = (left << half) | right;
+    } while (value >= domain);
+
+    return value;
+}
+
+uint32_t BidGenerator::pickFund(uint64_t random) const {
+    double point = (random >> 11) * (1.0 / 9007199254740992.0);
+    auto found = lower_bound(this->fundCdf.begin(), this->fundCdf.end(), point);
+    if (found == this->fundCdf.end()) {
+        return this->options.funds - 1;
+    }
+    return static_cast<uint32_t>(found - this->fundCdf.begin());
+}
+
+uint32_t BidGenerator::titleLengthFor(uint64_t random) const {
+    uint32_t range = this->options.titleMax - this->options.titleMin;
+    if (this->options.titleLength == TitleLength::Uniform) {
+        return this->options.titleMin + static_cast<uint32_t>(random % (range + 1));
+    }
+
+    // log-normal: Box-Muller from two 26-bit uniforms, median at a quarter
+    // of the range above the minimum
+    double u1 = ((random & 0x3FFFFFF) + 1.0) / 67108865.0;
+    double u2 = ((random >> 26) & 0x3FFFFFF) / 67108864.0;
+    double normal = sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+    double length = exp(log(range / 4.0 + 1.0) + 0.75 * normal);
+    return this->options.titleMin
+            + static_cast<uint32_t>(min<double>(length, range));
+}
+
+/**
+ * The bid id of a row under the configured distribution; ids are unique
+ * across the whole file
+ */
+uint32_t BidGenerator::BidId(uint64_t row) const {
+    uint64_t ordinal;
+    switch (this->options.ids) {
+    case IdDistribution::Sequential:
+        ordinal = row;
+        break;
+    case IdDistribution::Shuffled:
+        ordinal = this->permute(row, this->options.rows, 1);
+        break;
+    default: {
+        uint64_t clusters = (this->options.rows + this->options.clusterSize - 1)
+                / this->options.clusterSize;
+        uint64_t cluster = this->permute(row / this->options.clusterSize, clusters, 2);
+        ordinal = cluster * this->options.clusterSize * this->options.clusterSpread
+                + row % this->options.clusterSize;
+        break;
+    }
+    }
+    return static_cast<uint32_t>(this->options.firstId + ordinal * this->options.idStep);
+}
+
+/**
+ * Append one CSV row (without the newline). Quoted titles contain commas
+ * and, now and then, doubled quotes, exactly as the CSV parser sees them.
+ */
+void BidGenerator::AppendRow(uint64_t row, string& line) const {
+    const uint64_t base = mix64(this->options.seed) ^ (row * 0xD6E8FEB86659FD93ull);
+    auto random = [base](Field field) {
+        return mix64(base + field * 0x9E3779B97F4A7C15ull);
+    };
+
+    // ArticleTitle
+    uint32_t length = this->titleLengthFor(random(TITLE_LENGTH));
+    uint64_t quotedDraw = random(TITLE_QUOTED);
+    bool quoted = (quotedDraw >> 11) * (1.0 / 9007199254740992.0) < this->options.quotedRatio;
+    uint64_t words = random(TITLE_WORDS);
+
+    if (quoted) {
+        line += '"';
+    }
+    size_t textStart = line.size();
+    for (unsigned int word = 0; line.size() - textStart < length; ++word) {
+        if (word > 0) {
+            line += quoted ? ", " : " ";
+        }
+        if (word > 0 && word % 16 == 0) {
+            words = mix64(words);
+        }
+        line += WORDS[(words >> ((word % 16) * 4)) & 0xF];
+    }
+    line.resize(textStart + length);
+    if (!line.empty() && line.back() == ' ') {
+        line.back() = 'x';
+    }
+    if (quoted) {
+        if ((quotedDraw & 3) == 0) {
+            line += " 12\"\" wide";			// embedded (doubled) quotes
+        }
+        line += '"';
+    }
+
+    // ArticleID, Department, CloseDate
+    uint64_t date = random(CLOSE_DATE);
+    line += ',';
+    line += to_string(this->BidId(row));
+    line += ',';
+    line += DEPARTMENTS[random(DEPARTMENT) % 6];
+    line += ',';
+    line += to_string(date % 12 + 1);
+    line += '/';
+    line += to_string((date >> 8) % 28 + 1);
+    line += "/2016,";
+
+    // WinningBid
+    uint64_t cents = random(AMOUNT) % 5000000;
+    line += '$';
+    line += to_string(cents / 100);
+    line += '.';
+    line += char('0' + cents % 100 / 10);
+    line += char('0' + cents % 10);
+
+    // InventoryID, VehicleID (often empty in the real files), ReceiptNumber
+    uint64_t vehicle = random(VEHICLE);
+    line += ',';
+    line += to_string(100000 + row);
+    line += ',';
+    if (vehicle % 3 != 0) {
+        line += to_string(vehicle % 9000 + 1000);
+    }
+    line += ',';
+    line += to_string(900000000 + row);
+
+    // Fund
+    line += ',';
+    line += this->fundNames[this->pickFund(random(FUND))];
+}
+
+/**
+ * Build one row as a Bid, with the same field text loading the CSV gives
+ */
+Bid BidGenerator::MakeBid(uint64_t row) const {
+    string line;
+    this->AppendRow(row, line);
+
+    vector<string> fields;
+    bool quoted = false;
+    size_t start = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+        if (line[i] == '"') {
+            quoted = !quoted;
+        } else if (line[i] == ',' && !quoted) {
+            fields.push_back(line.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+    fields.push_back(line.substr(start));
+
+    return Bid(std::move(fields[BID_ID_COLUMN]), std::move(fields[TITLE_COLUMN]),
+            std::move(fields[FUND_COLUMN]), strToDouble(fields[AMOUNT_COLUMN], '$'));
+}
+
+/**
+ * Stream the header and every row, flushing about 1 MiB at a time
+ */
+void BidGenerator::WriteCsv(ostream& out) const {
+    string buffer;
+    buffer.reserve(1 << 21);
+    buffer += EBID_HEADER;
+    buffer += '\n';
+
+    for (uint64_t row = 0; row < this->options.rows; ++row) {
+        this->AppendRow(row, buffer);
+        buffer += '\n';
+        if (buffer.size() >= (1 << 20)) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), buffer.size());
+}
+
+/**
+ * The whole file as a string, e.g. for csv::Parser(text, csv::ePURE)
+ */
+string BidGenerator::Csv() const {
+    ostringstream out;
+    this->WriteCsv(out);
+    return out.str();
+}
+
+vector<Bid> BidGenerator::MakeBids() const {
+    vector<Bid> bids;
+    bids.reserve(this->options.rows);
+    for (uint64_t row = 0; row < this->options.rows; ++row) {
+        bids.push_back(this->MakeBid(row));
+    }
+    return bids;
+}
+
+const GeneratorOptions& BidGenerator::Options() const {
+    return this->options;
+}
+
+//============================================================================
+// Option parsing
+//============================================================================
+
+bool parseIdDistribution(const string& text, IdDistribution& ids) {
+    if (text == "sequential") {
+        ids = IdDistribution::Sequential;
+    } else if (text == "shuffled") {
+        ids = IdDistribution::Shuffled;
+    } else if (text == "clustered") {
+        ids = IdDistribution::Clustered;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseTitleLength(const string& text, TitleLength& length) {
+    if (text == "uniform") {
+        length = TitleLength::Uniform;
+    } else if (text == "lognormal") {
+        length = TitleLength::LogNormal;
+    } else {
+        return false;
+    }
+    return true;
+}
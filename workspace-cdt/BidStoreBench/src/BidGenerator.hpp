@@ -0,0 +1,85 @@
+//============================================================================
+// Name        : BidGenerator.hpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Synthetic eBid monthly sales data for scale testing
+//============================================================================
+
+#ifndef BIDGENERATOR_HPP_
+#define BIDGENERATOR_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Bid.hpp"
+
+// same 9 columns, in the same order, as the eBid monthly sales files
+extern const char* const EBID_HEADER;
+
+enum class IdDistribution {
+    Sequential,		// firstId, firstId + step, ... in row order
+    Shuffled,		// the sequential ids in a pseudo-random order
+    Clustered		// runs of consecutive ids separated by gaps, runs shuffled
+};
+
+enum class TitleLength {
+    Uniform,		// uniform between titleMin and titleMax
+    LogNormal		// mostly short titles with a long tail up to titleMax
+};
+
+struct GeneratorOptions {
+    uint64_t rows = 1000;
+    uint64_t seed = 260;
+
+    IdDistribution ids = IdDistribution::Shuffled;
+    uint32_t firstId = 10000;
+    uint32_t idStep = 1;				// gap between neighbouring ids
+    uint32_t clusterSize = 1000;		// ids per run (Clustered)
+    uint32_t clusterSpread = 10;		// run stride is clusterSize * spread
+
+    uint32_t funds = 8;					// distinct fund names
+    double fundSkew = 0.0;				// Zipf exponent, 0 = uniform
+
+    TitleLength titleLength = TitleLength::Uniform;
+    uint32_t titleMin = 8;
+    uint32_t titleMax = 48;
+
+    double quotedRatio = 0.25;			// titles quoted with embedded commas
+};
+
+/**
+ * Generates eBid rows deterministically from (seed, row number), so any
+ * row can be produced independently and 100M-row files can be streamed
+ * without holding ids or rows in memory.
+ */
+class BidGenerator {
+
+private:
+    GeneratorOptions options;
+    std::vector<double> fundCdf;		// cumulative fund weights
+    std::vector<std::string> fundNames;
+
+    uint64_t permute(uint64_t index, uint64_t domain, uint64_t salt) const;
+    uint32_t pickFund(uint64_t random) const;
+    uint32_t titleLengthFor(uint64_t random) const;
+
+public:
+    explicit BidGenerator(const GeneratorOptions& options);
+
+    uint32_t BidId(uint64_t row) const;
+    Bid MakeBid(uint64_t row) const;
+    void AppendRow(uint64_t row, std::string& line) const;
+    void WriteCsv(std::ostream& out) const;
+    std::string Csv() const;
+    std::vector<Bid> MakeBids() const;
+
+    const GeneratorOptions& Options() const;
+};
+
+bool parseIdDistribution(const std::string& text, IdDistribution& ids);
+bool parseTitleLength(const std::string& text, TitleLength& length);
+
+#endif /* BIDGENERATOR_HPP_ */
@@ -0,0 +1,573 @@
+//============================================================================
+// Name        : ContainerBenchmark.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Compares the bid containers on identical datasets
+//============================================================================
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "BinarySearchTree.hpp"
+#include "ChainedHashTable.hpp"
+#include "CuckooHashTable.hpp"
+#include "FilteredHashTable.hpp"
+#include "HashTable.hpp"
+#include "LinkedList.hpp"
+#include "PerfectHashTable.hpp"
+#include "SwissHashTable.hpp"
+
+using namespace std;
+
+//============================================================================
+// Container adapters
+//
+// Each adapter gives the harness the same five operations. linearLookup
+// marks containers whose lookups scan the whole container; their lookup
+// and remove counts are capped so large sizes finish in reasonable time.
+//============================================================================
+
+struct LinkedListBench {
+    static constexpr const char* name = "LinkedList";
+    static constexpr bool linearLookup = true;
+    static constexpr bool bulkInsert = false;
+    LinkedList list;
+
+    void Insert(const Bid& bid) { this->list.Append(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->list.Find(bidId); }
+    bool Remove(const string& bidId) { return this->list.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->list.ForEach(visit); }
+};
+
+struct HashTableBench {
+    static constexpr const char* name = "HashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = false;
+    HashTable table;
+
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->table.Find(bidId); }
+    size_t FindMany(const vector<string>& bidIds, vector<const Bid*>& bids) const {
+        return this->table.SearchMany(bidIds, bids);
+    }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table.ForEach(visit); }
+};
+
+/**
+ * HashTable with incremental growth, to compare insert tail latency
+ * against the all-at-once rebuild
+ */
+struct IncrementalHashTableBench {
+    static constexpr const char* name = "IncrementalHashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = false;
+    HashTable table;
+
+    IncrementalHashTableBench() { this->table.SetIncrementalGrowth(true); }
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->table.Find(bidId); }
+    size_t FindMany(const vector<string>& bidIds, vector<const Bid*>& bids) const {
+        return this->table.SearchMany(bidIds, bids);
+    }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table.ForEach(visit); }
+};
+
+/**
+ * HashTable filled by one parallel BulkLoad, timed as a whole like the
+ * sorted vector
+ */
+struct BulkLoadedHashTableBench {
+    static constexpr const char* name = "BulkLoadedHashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = true;
+    HashTable table;
+    vector<Bid> pending;
+
+    void Insert(const Bid& bid) { this->pending.push_back(bid); }
+    void Finish() {
+        this->table.BulkLoad(std::move(this->pending));
+        this->pending.clear();
+    }
+    const Bid* Find(const string& bidId) const { return this->table.Find(bidId); }
+    size_t FindMany(const vector<string>& bidIds, vector<const Bid*>& bids) const {
+        return this->table.SearchMany(bidIds, bids);
+    }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table.ForEach(visit); }
+};
+
+/**
+ * HashTable behind a blocked Bloom filter that turns most misses away
+ */
+struct FilteredHashTableBench {
+    static constexpr const char* name = "FilteredHashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = false;
+    FilteredHashTable table;
+
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->table.Find(bidId); }
+    size_t FindMany(const vector<string>& bidIds, vector<const Bid*>& bids) const {
+        return this->table.SearchMany(bidIds, bids);
+    }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table.ForEach(visit); }
+};
+
+/**
+ * Swiss-table layout: bids in place, 16 control bytes matched at once
+ */
+struct SwissHashTableBench {
+    static constexpr const char* name = "SwissHashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = false;
+    SwissHashTable table;
+
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->table.Find(bidId); }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table.ForEach(visit); }
+};
+
+/**
+ * Bucketized cuckoo hashing: two 4-slot buckets and a stash per lookup
+ */
+struct CuckooHashTableBench {
+    static constexpr const char* name = "CuckooHashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = false;
+    CuckooHashTable table;
+
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->table.Find(bidId); }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table.ForEach(visit); }
+};
+
+/**
+ * Read-only snapshot of the loaded bids under a minimal perfect hash; it
+ * has no Remove, so the remove pass is skipped
+ */
+struct PerfectHashTableBench {
+    static constexpr const char* name = "PerfectHashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = true;
+    vector<Bid> pending;
+    unique_ptr<PerfectHashTable> table;
+
+    void Insert(const Bid& bid) { this->pending.push_back(bid); }
+    void Finish() {
+        this->table.reset(new PerfectHashTable(std::move(this->pending)));
+        this->pending.clear();
+    }
+    const Bid* Find(const string& bidId) const { return this->table->Find(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table->ForEach(visit); }
+};
+
+struct ChainedHashTableBench {
+    static constexpr const char* name = "ChainedHashTable";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = false;
+    ChainedHashTable table;
+
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->table.Find(bidId); }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->table.ForEach(visit); }
+};
+
+struct BinarySearchTreeBench {
+    static constexpr const char* name = "BinarySearchTree";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = false;
+    BinarySearchTree tree;
+
+    void Insert(const Bid& bid) { this->tree.Insert(bid); }
+    void Finish() {}
+    const Bid* Find(const string& bidId) const { return this->tree.Find(bidId); }
+    bool Remove(const string& bidId) { this->tree.Remove(bidId); return true; }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const { this->tree.ForEach(visit); }
+};
+
+/**
+ * vector<Bid> kept sorted by bidId. Inserts are appended and sorted once
+ * in Finish(), which is how a sorted vector is normally loaded, so the
+ * insert row is amortized and carries no per-operation latencies.
+ */
+struct SortedVectorBench {
+    static constexpr const char* name = "SortedVector";
+    static constexpr bool linearLookup = false;
+    static constexpr bool bulkInsert = true;
+    vector<Bid> bids;
+
+    static bool lessById(const Bid& bid, const string& bidId) {
+        return bid.bidId < bidId;
+    }
+
+    void Insert(const Bid& bid) { this->bids.push_back(bid); }
+    void Finish() {
+        sort(this->bids.begin(), this->bids.end(),
+                [](const Bid& a, const Bid& b) { return a.bidId < b.bidId; });
+    }
+    const Bid* Find(const string& bidId) const {
+        auto found = lower_bound(this->bids.begin(), this->bids.end(), bidId, lessById);
+        return (found != this->bids.end() && found->bidId == bidId) ? &*found : nullptr;
+    }
+    bool Remove(const string& bidId) {
+        auto found = lower_bound(this->bids.begin(), this->bids.end(), bidId, lessById);
+        if (found == this->bids.end() || found->bidId != bidId) {
+            return false;
+        }
+        this->bids.erase(found);
+        return true;
+    }
+    template<typename Visitor>
+    void ForEach(Visitor visit) const {
+        for (const Bid& bid : this->bids) {
+            visit(bid);
+        }
+    }
+};
+
+//============================================================================
+// Harness
+//============================================================================
+
+struct BenchOptions {
+    vector<size_t> sizes = { 1000, 10000, 100000 };
+    size_t lookups = 100000;			// lookups per size (hit and miss each)
+    size_t removes = 10000;				// removes per size
+    size_t linearBudget = 50000000;	// max compares for linear containers
+    uint64_t seed = 260;
+    IdDistribution ids = IdDistribution::Shuffled;
+    string csvPath;
+    string jsonPath;
+    string only;						// run a single container
+};
+
+/**
+ * Time lookups twice: once as a tight loop for ns/op, once with every
+ * lookup timed for the latency percentiles
+ */
+template<typename Container>
+BenchmarkResult timeLookups(const Container& container, const char* operation,
+        const vector<string>& keys, size_t size) {
+    BenchmarkResult result;
+    result.container = Container::name;
+    result.operation = operation;
+    result.size = size;
+    result.ops = keys.size();
+
+    size_t found = 0;
+    uint64_t start = nowNs();
+    for (const string& key : keys) {
+        found += container.Find(key) != nullptr;
+    }
+    uint64_t elapsed = nowNs() - start;
+    doNotOptimize(found);
+    result.nsPerOp = static_cast<double>(elapsed) / max<size_t>(keys.size(), 1);
+
+    LatencyRecorder latencies;
+    latencies.Reserve(keys.size());
+    for (const string& key : keys) {
+        uint64_t opStart = nowNs();
+        const Bid* bid = container.Find(key);
+        latencies.Add(nowNs() - opStart);
+        doNotOptimize(bid);
+    }
+    latencies.Summarize(result);
+    return result;
+}
+
+/**
+ * Time lookups handed over as one batch, for containers that take them
+ */
+template<typename Container>
+BenchmarkResult timeBatchLookups(const Container& container, const char* operation,
+        const vector<string>& keys, size_t size) {
+    BenchmarkResult result;
+    result.container = Container::name;
+    result.operation = operation;
+    result.size = size;
+    result.ops = keys.size();
+
+    vector<const Bid*> bids(keys.size());
+    uint64_t start = nowNs();
+    size_t found = container.FindMany(keys, bids);
+    uint64_t elapsed = nowNs() - start;
+    doNotOptimize(found);
+    result.nsPerOp = static_cast<double>(elapsed) / max<size_t>(keys.size(), 1);
+    LatencyRecorder().Summarize(result);
+    return result;
+}
+
+/**
+ * Remove distinct bids in random order, each removal timed
+ */
+template<typename Container>
+void runRemoves(Container& container, const vector<Bid>& dataset, size_t size,
+        const BenchOptions& options, mt19937_64& random, BenchmarkReport& report) {
+    size_t removes = min(options.removes, size);
+    if (Container::linearLookup || Container::bulkInsert) {
+        removes = min(removes, max<size_t>(100, options.linearBudget / max<size_t>(size, 1)));
+    }
+    vector<string> victims;
+    victims.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        victims.push_back(dataset[i].bidId);
+    }
+    shuffle(victims.begin(), victims.end(), random);
+    victims.resize(removes);
+
+    BenchmarkResult remove;
+    remove.container = Container::name;
+    remove.operation = "remove";
+    remove.size = size;
+    LatencyRecorder removeLatencies;
+    removeLatencies.Reserve(removes);
+    for (const string& bidId : victims) {
+        uint64_t opStart = nowNs();
+        bool removed = container.Remove(bidId);
+        removeLatencies.Add(nowNs() - opStart);
+        doNotOptimize(removed);
+    }
+    removeLatencies.Summarize(remove);
+    report.Add(remove);
+}
+
+/**
+ * Replace the container's bids one at a time, each step removing a random
+ * bid and inserting one, as many times as there are bids; then time the
+ * misses again, which shows whether removals leave probes longer
+ */
+template<typename Container>
+void runChurn(Container& container, const vector<Bid>& dataset, size_t size,
+        const vector<string>& misses, mt19937_64& random, BenchmarkReport& report) {
+    BenchmarkResult churn;
+    churn.container = Container::name;
+    churn.operation = "churn";
+    churn.size = size;
+    churn.ops = size;
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < size; ++i) {
+        const Bid& bid = dataset[random() % size];
+        container.Remove(bid.bidId);
+        container.Insert(bid);
+    }
+    churn.nsPerOp = static_cast<double>(nowNs() - start) / max<size_t>(size, 1);
+    LatencyRecorder().Summarize(churn);
+    report.Add(churn);
+
+    report.Add(timeLookups(container, "find_miss_churned", misses, size));
+}
+
+/**
+ * Run insert, hit and miss lookup, traversal, remove and churn on one container
+ * loaded with the first size bids of the dataset
+ */
+template<typename Container>
+void runContainer(const vector<Bid>& dataset, size_t size,
+        const BenchOptions& options, BenchmarkReport& report) {
+    if (!options.only.empty() && options.only != Container::name) {
+        return;
+    }
+
+    mt19937_64 random(options.seed + size);
+    unique_ptr<Container> container(new Container());
+
+    // insert
+    BenchmarkResult insert;
+    insert.container = Container::name;
+    insert.operation = "insert";
+    insert.size = size;
+    insert.ops = size;
+    LatencyRecorder insertLatencies;
+    if (Container::bulkInsert) {
+        uint64_t start = nowNs();
+        for (size_t i = 0; i < size; ++i) {
+            container->Insert(dataset[i]);
+        }
+        container->Finish();
+        insert.nsPerOp = static_cast<double>(nowNs() - start) / max<size_t>(size, 1);
+    } else {
+        insertLatencies.Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            uint64_t opStart = nowNs();
+            container->Insert(dataset[i]);
+            insertLatencies.Add(nowNs() - opStart);
+        }
+        container->Finish();
+    }
+    insertLatencies.Summarize(insert);
+    report.Add(insert);
+
+    // lookups: linear containers get a compare budget instead of the full count
+    size_t lookups = options.lookups;
+    if (Container::linearLookup) {
+        lookups = min(lookups, max<size_t>(100, options.linearBudget / max<size_t>(size, 1)));
+    }
+
+    vector<string> hits;
+    hits.reserve(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        hits.push_back(dataset[random() % size].bidId);
+    }
+    vector<Bid> loaded(dataset.begin(), dataset.begin() + size);
+    vector<string> misses = makeMissingIds(loaded, lookups, options.seed + size + 1);
+
+    report.Add(timeLookups(*container, "find_hit", hits, size));
+    report.Add(timeLookups(*container, "find_miss", misses, size));
+    if constexpr (requires { container->FindMany(hits, declval<vector<const Bid*>&>()); }) {
+        report.Add(timeBatchLookups(*container, "batch_hit", hits, size));
+        report.Add(timeBatchLookups(*container, "batch_miss", misses, size));
+    }
+
+    // full traversal, repeated until at least ~50ms have been measured
+    BenchmarkResult traverse;
+    traverse.container = Container::name;
+    traverse.operation = "traverse";
+    traverse.size = size;
+    uint64_t traverseTime = 0;
+    size_t visited = 0;
+    do {
+        double amount = 0.0;
+        uint64_t start = nowNs();
+        container->ForEach([&amount, &visited](const Bid& bid) {
+            amount += bid.amount;
+            ++visited;
+        });
+        traverseTime += nowNs() - start;
+        doNotOptimize(amount);
+    } while (traverseTime < 50000000 && visited < 100 * max<size_t>(size, 1));
+    traverse.ops = visited;
+    traverse.nsPerOp = static_cast<double>(traverseTime) / max<size_t>(visited, 1);
+    LatencyRecorder().Summarize(traverse);
+    report.Add(traverse);
+
+    // remove distinct bids in random order, where the container allows it
+    if constexpr (requires { container->Remove(string()); }) {
+        runRemoves(*container, dataset, size, options, random, report);
+        if constexpr (!Container::linearLookup && !Container::bulkInsert) {
+            runChurn(*container, dataset, size, misses, random, report);
+        }
+    }
+}
+
+void usage(const char* program) {
+    cerr << "usage: " << program << " [--sizes N,N,...] [--lookups N]"
+            << " [--removes N] [--seed N] [--ids sequential|shuffled|clustered]"
+            << " [--csv file] [--json file]"
+            << " [--only LinkedList|HashTable|IncrementalHashTable"
+            << "|BulkLoadedHashTable|FilteredHashTable|SwissHashTable|CuckooHashTable"
+            << "|PerfectHashTable|ChainedHashTable|BinarySearchTree|SortedVector]"
+            << endl;
+}
+
+/**
+ * The one and only main() method
+ */
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--sizes") {
+            options.sizes = parseSizes(value);
+        } else if (arg == "--lookups") {
+            options.lookups = stoull(value);
+        } else if (arg == "--removes") {
+            options.removes = stoull(value);
+        } else if (arg == "--seed") {
+            options.seed = stoull(value);
+        } else if (arg == "--ids") {
+            if (!parseIdDistribution(value, options.ids)) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--csv") {
+            options.csvPath = value;
+        } else if (arg == "--json") {
+            options.jsonPath = value;
+        } else if (arg == "--only") {
+            options.only = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    size_t largest = *max_element(options.sizes.begin(), options.sizes.end());
+
+    // every container sees the same bids in the same insertion order
+    vector<Bid> dataset;
+    if (!options.csvPath.empty()) {
+        try {
+            dataset = loadBidsFromCsv(options.csvPath);
+        } catch (csv::Error &e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    } else {
+        dataset = makeBids(largest, options.seed, options.ids);
+    }
+
+    BenchmarkReport report("containers");
+    for (size_t size : options.sizes) {
+        if (size > dataset.size()) {
+            cerr << "skipping size " << size << ": dataset has only "
+                    << dataset.size() << " bids" << endl;
+            continue;
+        }
+        runContainer<LinkedListBench>(dataset, size, options, report);
+        runContainer<HashTableBench>(dataset, size, options, report);
+        runContainer<IncrementalHashTableBench>(dataset, size, options, report);
+        runContainer<BulkLoadedHashTableBench>(dataset, size, options, report);
+        runContainer<FilteredHashTableBench>(dataset, size, options, report);
+        runContainer<SwissHashTableBench>(dataset, size, options, report);
+        runContainer<CuckooHashTableBench>(dataset, size, options, report);
+        runContainer<PerfectHashTableBench>(dataset, size, options, report);
+        runContainer<ChainedHashTableBench>(dataset, size, options, report);
+        runContainer<BinarySearchTreeBench>(dataset, size, options, report);
+        runContainer<SortedVectorBench>(dataset, size, options, report);
+    }
+
+    report.PrintTable(cout);
+    if (!options.jsonPath.empty() && !report.WriteJson(options.jsonPath)) {
+        cerr << "could not write " << options.jsonPath << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+//============================================================================
+// Name        : HashReport.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Collision and bucket distribution report for bid id hashes
+//============================================================================
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "ChainedHashTable.hpp"
+#include "CuckooHashTable.hpp"
+#include "HashFunctions.hpp"
+#include "HashTable.hpp"
+#include "TableStats.hpp"
+
+using namespace std;
+
+void usage(const char* program) {
+    cerr << "usage: " << program << " [--csv file | --rows N"
+            << " --ids sequential|shuffled|clustered] [--seed N]\n"
+            << "    [--hash bidid,string,std,atoi] [--buckets N,N,...]"
+            << " [--tables HashTable,ChainedHashTable,CuckooHashTable]" << endl;
+}
+
+/**
+ * Split a comma-separated list
+ */
+vector<string> parseNames(const string& value) {
+    vector<string> names;
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t comma = value.find(',', start);
+        if (comma == string::npos) {
+            comma = value.size();
+        }
+        names.push_back(value.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return names;
+}
+
+/**
+ * Load the bids into a table and print how they sit in it
+ */
+template<typename Table>
+void printLoadedTableStats(const string& name, const vector<Bid>& bids) {
+    Table table;
+    for (const Bid& bid : bids) {
+        table.Insert(bid);
+    }
+    cout << endl << name << endl;
+    printTableStats(cout, table.Stats());
+}
+
+/**
+ * The one and only main() method
+ *
+ * Hashes every id of an eBid file (or of a synthetic one) with each hash
+ * function and reports how the ids spread over tables of the given sizes.
+ * By default the sizes are the power-of-two slot count HashTable would use
+ * and a prime bucket count close to the number of ids. With --tables, the
+ * bids are then loaded into each named table and its own statistics
+ * (probe lengths, empty buckets, memory) are printed as well.
+ */
+int main(int argc, char* argv[]) {
+    string csvPath;
+    GeneratorOptions generator;
+    generator.rows = 100000;
+    vector<string> hashNames = { "bidid", "string", "std", "atoi" };
+    vector<size_t> buckets;
+    vector<string> tableNames;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--csv") {
+            csvPath = value;
+        } else if (arg == "--rows") {
+            generator.rows = stoull(value);
+        } else if (arg == "--ids") {
+            if (!parseIdDistribution(value, generator.ids)) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--seed") {
+            generator.seed = stoull(value);
+        } else if (arg == "--hash") {
+            hashNames = parseNames(value);
+        } else if (arg == "--buckets") {
+            buckets = parseSizes(value);
+        } else if (arg == "--tables") {
+            tableNames = parseNames(value);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    vector<Bid> bids;
+    vector<string> ids;
+    try {
+        bids = csvPath.empty()
+                ? BidGenerator(generator).MakeBids()
+                : loadBidsFromCsv(csvPath);
+        ids.reserve(bids.size());
+        for (const Bid& bid : bids) {
+            ids.push_back(bid.bidId);
+        }
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    if (buckets.empty()) {
+        size_t slots = 256;
+        while (slots * 7 / 8 < ids.size()) {
+            slots *= 2;
+        }
+        size_t prime = ids.size() | 1;
+        for (bool composite = true; composite; prime += 2) {
+            composite = prime < 3;
+            for (size_t divisor = 3; divisor <= prime / divisor; divisor += 2) {
+                if (prime % divisor == 0) {
+                    composite = true;
+                    break;
+                }
+            }
+            if (!composite) {
+                break;
+            }
+        }
+        buckets = { slots, prime };
+    }
+
+    printHashReportHeader(cout);
+    for (size_t bucketCount : buckets) {
+        for (const string& name : hashNames) {
+            BidHashFunction function;
+            if (!findHashFunction(name, function)) {
+                cerr << "unknown hash " << name << endl;
+                return 1;
+            }
+            printHashReport(cout, name, analyzeHash(ids, function, bucketCount));
+        }
+    }
+
+    for (const string& name : tableNames) {
+        if (name == "HashTable") {
+            printLoadedTableStats<HashTable>(name, bids);
+        } else if (name == "ChainedHashTable") {
+            printLoadedTableStats<ChainedHashTable>(name, bids);
+        } else if (name == "CuckooHashTable") {
+            printLoadedTableStats<CuckooHashTable>(name, bids);
+        } else {
+            cerr << "unknown table " << name << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
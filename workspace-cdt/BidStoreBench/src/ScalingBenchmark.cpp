@@ -0,0 +1,319 @@
+//============================================================================
+// Name        : ScalingBenchmark.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Throughput of the shared bid tables as threads are added
+//============================================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "ConcurrentHashTable.hpp"
+#include "EpochHashTable.hpp"
+#include "HashTable.hpp"
+#include "ShardedHashTable.hpp"
+
+using namespace std;
+
+//============================================================================
+// Table adapters
+//
+// Each adapter gives the harness Insert, Remove and Contains, safe to call
+// from any number of threads.
+//============================================================================
+
+/**
+ * One HashTable behind one reader/writer lock: the baseline the striped
+ * table has to beat
+ */
+struct LockedHashTableBench {
+    static constexpr const char* name = "LockedHashTable";
+    mutable shared_mutex lock;
+    HashTable table;
+
+    void Reserve(size_t count) { this->table.Reserve(count); }
+    void Insert(const Bid& bid) {
+        unique_lock<shared_mutex> guard(this->lock);
+        this->table.Insert(bid);
+    }
+    bool Remove(const string& bidId) {
+        unique_lock<shared_mutex> guard(this->lock);
+        return this->table.Remove(bidId);
+    }
+    bool Contains(const string& bidId, double& amount) const {
+        shared_lock<shared_mutex> guard(this->lock);
+        const Bid* bid = this->table.Find(bidId);
+        if (bid != nullptr) {
+            amount += bid->amount;
+        }
+        return bid != nullptr;
+    }
+};
+
+struct ConcurrentHashTableBench {
+    static constexpr const char* name = "ConcurrentHashTable";
+    ConcurrentHashTable table;
+
+    void Reserve(size_t count) { this->table.Reserve(count); }
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    bool Contains(const string& bidId, double& amount) const {
+        return this->table.Visit(bidId, [&amount](const Bid& bid) {
+            amount += bid.amount;
+        });
+    }
+};
+
+/**
+ * Lock-free lookups: readers only announce an epoch in their own record
+ */
+struct EpochHashTableBench {
+    static constexpr const char* name = "EpochHashTable";
+    EpochHashTable table;
+
+    void Reserve(size_t count) { this->table.Reserve(count); }
+    void Insert(const Bid& bid) { this->table.Insert(bid); }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId); }
+    bool Contains(const string& bidId, double& amount) const {
+        return this->table.Visit(bidId, [&amount](const Bid& bid) {
+            amount += bid.amount;
+        });
+    }
+};
+
+/**
+ * Shards owned by worker threads; each call here waits on its future, so
+ * this measures a round trip through a shard queue per operation
+ */
+struct ShardedHashTableBench {
+    static constexpr const char* name = "ShardedHashTable";
+    mutable ShardedHashTable table;
+
+    void Reserve(size_t count) { this->table.Reserve(count); }
+    void Insert(const Bid& bid) { this->table.Insert(bid).get(); }
+    bool Remove(const string& bidId) { return this->table.Remove(bidId).get(); }
+    bool Contains(const string& bidId, double& amount) const {
+        Bid bid = this->table.Search(bidId).get();
+        amount += bid.amount;
+        return !bid.bidId.empty();
+    }
+};
+
+//============================================================================
+// Harness
+//============================================================================
+
+/**
+ * A mix of operations, in percent; the rest are lookups
+ */
+struct Workload {
+    const char* name;
+    unsigned int insertPercent;
+    unsigned int removePercent;
+};
+
+const Workload WORKLOADS[] = {
+    { "read_heavy", 1, 1 },		// 98% lookups
+    { "mixed", 25, 25 },		// 50% lookups
+};
+
+struct ScaleOptions {
+    size_t size = 100000;				// bids loaded before timing
+    vector<size_t> threads = { 1, 2, 4, 8, 16, 32, 64 };
+    size_t ops = 100000;				// operations per thread
+    uint64_t seed = 260;
+    string workload;					// run a single workload
+    string only;						// run a single table
+    string jsonPath;
+};
+
+/**
+ * Small per-thread generator for picking keys and operations, cheap
+ * enough not to show up in the timings
+ */
+struct XorShift {
+    uint64_t state;
+
+    uint64_t operator()() {
+        this->state ^= this->state << 13;
+        this->state ^= this->state >> 7;
+        this->state ^= this->state << 17;
+        return this->state;
+    }
+};
+
+/**
+ * Run one workload on a fresh table with a number of threads. The table
+ * starts with the first half of the pool loaded; keys are drawn from the
+ * whole pool, so about half the lookups and removes hit.
+ */
+template<typename Table>
+BenchmarkResult runWorkload(const vector<Bid>& pool, const Workload& workload,
+        size_t threadCount, const ScaleOptions& options) {
+    unique_ptr<Table> table(new Table());
+    table->Reserve(pool.size());
+    for (size_t i = 0; i < pool.size() / 2; ++i) {
+        table->Insert(pool[i]);
+    }
+
+    latch start(static_cast<ptrdiff_t>(threadCount + 1));
+    vector<thread> workers;
+    for (size_t t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            XorShift random{ options.seed * 0x9E3779B97F4A7C15ull + t + 1 };
+            double amount = 0.0;
+            size_t found = 0;
+            start.arrive_and_wait();
+            for (size_t i = 0; i < options.ops; ++i) {
+                const Bid& bid = pool[random() % pool.size()];
+                unsigned int roll = random() % 100;
+                if (roll < workload.insertPercent) {
+                    table->Insert(bid);
+                } else if (roll < workload.insertPercent + workload.removePercent) {
+                    found += table->Remove(bid.bidId);
+                } else {
+                    found += table->Contains(bid.bidId, amount);
+                }
+            }
+            doNotOptimize(amount);
+            doNotOptimize(found);
+        });
+    }
+
+    start.arrive_and_wait();
+    uint64_t begin = nowNs();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    uint64_t elapsed = nowNs() - begin;
+
+    BenchmarkResult result;
+    result.container = Table::name;
+    result.operation = workload.name;
+    result.size = pool.size() / 2;
+    result.threads = static_cast<unsigned int>(threadCount);
+    result.ops = options.ops * threadCount;
+    // time per operation as each thread sees it, so ops/s = ops / elapsed
+    result.nsPerOp = static_cast<double>(elapsed) * threadCount / max<size_t>(result.ops, 1);
+    result.opsPerSecond = result.ops * 1e9 / max<uint64_t>(elapsed, 1);
+    LatencyRecorder().Summarize(result);
+    return result;
+}
+
+template<typename Table>
+void runTable(const vector<Bid>& pool, const ScaleOptions& options,
+        BenchmarkReport& report, vector<BenchmarkResult>& results) {
+    if (!options.only.empty() && options.only != Table::name) {
+        return;
+    }
+    for (const Workload& workload : WORKLOADS) {
+        if (!options.workload.empty() && options.workload != workload.name) {
+            continue;
+        }
+        for (size_t threads : options.threads) {
+            BenchmarkResult result = runWorkload<Table>(pool, workload, threads, options);
+            report.Add(result);
+            results.push_back(result);
+        }
+    }
+}
+
+/**
+ * Print throughput and speedup over the first thread count of each
+ * table and workload
+ */
+void printScaling(ostream& out, const vector<BenchmarkResult>& results) {
+    out << endl << left << setw(22) << "container" << setw(14) << "workload"
+            << right << setw(8) << "threads" << setw(12) << "Mops/s"
+            << setw(10) << "speedup" << endl;
+    double baseline = 0.0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        if (i == 0 || result.container != results[i - 1].container
+                || result.operation != results[i - 1].operation) {
+            baseline = result.opsPerSecond;
+        }
+        out << left << setw(22) << result.container << setw(14)
+                << result.operation << right << setw(8) << result.threads
+                << fixed << setprecision(2) << setw(12)
+                << result.opsPerSecond / 1e6 << setw(10)
+                << result.opsPerSecond / max(baseline, 1.0) << endl;
+    }
+    out.unsetf(ios::floatfield);
+}
+
+void usage(const char* program) {
+    cerr << "usage: " << program << " [--size N] [--threads N,N,...]"
+            << " [--ops N] [--seed N] [--workload read_heavy|mixed]"
+            << " [--only LockedHashTable|ConcurrentHashTable|EpochHashTable|ShardedHashTable]"
+            << " [--json file]"
+            << endl;
+}
+
+/**
+ * The one and only main() method
+ */
+int main(int argc, char* argv[]) {
+    ScaleOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--size") {
+            options.size = stoull(value);
+        } else if (arg == "--threads") {
+            options.threads = parseSizes(value);
+        } else if (arg == "--ops") {
+            options.ops = stoull(value);
+        } else if (arg == "--seed") {
+            options.seed = stoull(value);
+        } else if (arg == "--workload") {
+            options.workload = value;
+        } else if (arg == "--only") {
+            options.only = value;
+        } else if (arg == "--json") {
+            options.jsonPath = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.size == 0 || options.threads.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+
+    vector<Bid> pool = makeBids(options.size * 2, options.seed);
+    BenchmarkReport report("scaling");
+    vector<BenchmarkResult> results;
+    runTable<LockedHashTableBench>(pool, options, report, results);
+    runTable<ConcurrentHashTableBench>(pool, options, report, results);
+    runTable<EpochHashTableBench>(pool, options, report, results);
+    runTable<ShardedHashTableBench>(pool, options, report, results);
+
+    report.PrintTable(cout);
+    printScaling(cout, results);
+    if (!options.jsonPath.empty() && !report.WriteJson(options.jsonPath)) {
+        cerr << "could not write " << options.jsonPath << endl;
+        return 1;
+    }
+
+    return 0;
+}
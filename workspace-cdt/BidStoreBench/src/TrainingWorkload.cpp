@@ -0,0 +1,123 @@
+//============================================================================
+// Name        : TrainingWorkload.cpp
+// Author      : Jeff Perkinson
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Load-and-lookup workload used to train profile-guided builds
+//============================================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BidGenerator.hpp"
+#include "BinarySearchTree.hpp"
+#include "CompactBid.hpp"
+#include "CSVparser.hpp"
+#include "HashTable.hpp"
+#include "LinkedList.hpp"
+
+using namespace std;
+
+const unsigned int DEFAULT_ROWS = 20000;
+const unsigned int LIST_ROWS = 2000;		// linked list lookups are O(n)
+
+/**
+ * Parse the CSV, load every container and look bids up (hits and misses)
+ * the way the menu programs do
+ */
+int main(int argc, char* argv[]) {
+    unsigned int rows = DEFAULT_ROWS;
+    if (argc > 2) {
+        rows = static_cast<unsigned int>(atoi(argv[2]));
+    }
+
+    // synthetic rows mix quoted titles, skewed funds and shuffled ids
+    GeneratorOptions synthetic;
+    synthetic.rows = rows;
+    synthetic.fundSkew = 1.0;
+    synthetic.titleLength = TitleLength::LogNormal;
+
+    vector<Bid> bids;
+    try {
+        csv::Parser file = (argc > 1 && string(argv[1]) != "-")
+                ? csv::Parser(argv[1])
+                : csv::Parser(BidGenerator(synthetic).Csv(), csv::ePURE);
+        bids.reserve(file.rowCount());
+        for (unsigned int i = 0; i < file.rowCount(); i++) {
+            bids.push_back(bidFromRow(file[i]));
+        }
+    } catch (csv::Error &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    uint64_t checksum = 0;
+
+    // hash table: load, hit and miss lookups, remove a third
+    HashTable hashTable;
+    hashTable.Reserve(bids.size());
+    for (const Bid& bid : bids) {
+        hashTable.Insert(bid);
+    }
+    for (const Bid& bid : bids) {
+        checksum += hashTable.Find(bid.bidId) != nullptr;
+        checksum += hashTable.Find(bid.bidId + "x") != nullptr;
+    }
+    for (size_t i = 0; i < bids.size(); i += 3) {
+        checksum += hashTable.Remove(bids[i].bidId);
+    }
+
+    // binary search tree: load and look up every bid
+    BinarySearchTree tree;
+    for (const Bid& bid : bids) {
+        tree.Insert(bid);
+    }
+    for (const Bid& bid : bids) {
+        checksum += tree.Find(bid.bidId) != nullptr;
+    }
+
+    // linked list: a smaller prefix, lookups scan the list
+    LinkedList list;
+    size_t listRows = min<size_t>(bids.size(), LIST_ROWS);
+    for (size_t i = 0; i < listRows; ++i) {
+        list.Append(bids[i]);
+    }
+    for (size_t i = 0; i < listRows; i += 7) {
+        checksum += list.Find(bids[i].bidId) != nullptr;
+    }
+
+    // sorted vector: sort by id, binary search
+    vector<Bid> sorted = bids;
+    sort(sorted.begin(), sorted.end(), [](const Bid& a, const Bid& b) {
+        return a.bidId < b.bidId;
+    });
+    for (const Bid& bid : bids) {
+        checksum += binary_search(sorted.begin(), sorted.end(), bid,
+                [](const Bid& a, const Bid& b) {
+                    return a.bidId < b.bidId;
+                });
+    }
+
+    // compact catalog
+    BidCatalog catalog;
+    catalog.Reserve(bids.size());
+    for (const Bid& bid : bids) {
+        uint32_t bidId;
+        if (parseBidId(bid.bidId, bidId)) {
+            catalog.Add(bidId, bid.title, bid.fund,
+                    static_cast<int64_t>(bid.amount * 100 + 0.5));
+        }
+    }
+    checksum += catalog.Size();
+    for (const Bid& bid : bids) {
+        checksum += catalog.Find(bid.bidId) != nullptr;
+    }
+
+    cout << bids.size() << " bids, checksum " << checksum << endl;
+
+    return 0;
+}
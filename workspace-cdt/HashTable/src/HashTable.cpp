@@ -6,291 +6,26 @@
 // Description : Hello World in C++, Ansi-style
 //============================================================================
 
-#include <algorithm>
-#include <climits>
 #include <iostream>
-#include <string> // atoi
 #include <time.h>
 
 #include "CSVparser.hpp"
+#include "FundIndexedHashTable.hpp"
+#include "TableStats.hpp"
 
 using namespace std;
 
-//============================================================================
-// Global definitions visible to all methods and classes
-//============================================================================
-
-const unsigned int DEFAULT_SIZE = 179;
-const unsigned int DEFAULT_KEY = UINT_MAX;			// max unsigned int value
-
-// forward declarations
-double strToDouble(string str, char ch);
-
-
-// define a structure to hold bid information
-struct Bid {
-    string bidId; // unique identifier
-    string title;
-    string fund;
-    double amount;
-    Bid() {
-        amount = 0.0;
-    }
-};
-
-void displayBid(Bid bid);
-
-//============================================================================
-// Hash Table class definition
-//============================================================================
-
-/**
- * Define a class containing data members and methods to
- * implement a hash table with chaining.
- */
-class HashTable {
-
-private:
-    //(1): Define structures to hold bids
-	struct BidNode {
-		Bid bid;
-		unsigned int key;		// key value for hashing
-		BidNode* next;			// for implementing collision chaining
-
-		// default constructor
-		BidNode() {
-			this->key = DEFAULT_KEY;
-			this->next = nullptr;
-		}
-
-		// initialize a bid node with a bid
-		BidNode(Bid bid) {
-			BidNode();			// initialize an empty node with null next
-			this->bid = bid;	// set the bid in the node to the bid passed in
-		}
-
-		// initialize with a bid and a key
-		BidNode(Bid bid, unsigned int key) {
-			BidNode();
-			this->bid = bid;
-			this-> key = key;			// set key to the key passed in
-		}
-	};
-
-	vector<BidNode> bidNodes;			// vector to hold bid nodes
-
-	// Define the hash table size for the modulo hash algorithm
-	// DEFAULT_SIZE is 179 (smaller monthly file for testing)
-	unsigned int tableSize = DEFAULT_SIZE;
-
-    unsigned int hash(int key);
-
-public:
-    HashTable();
-    virtual ~HashTable();
-    void Insert(Bid bid);
-    void PrintAll();
-    void Remove(string bidId);
-    Bid Search(string bidId);
-};
-
-/**
- * Default constructor
- */
-HashTable::HashTable() {
-    // (2): Initialize the structures used to hold bids
-	bidNodes.resize(tableSize);					// resize the vector to the desired size
-}
-
-/**
- * Destructor
- */
-HashTable::~HashTable() {
-    // (3): Implement logic to free storage when class is destroyed
-	// erase function removes specified elements from the vector
-	// begin() denotes removal of the first element in the vector
-	this->bidNodes.erase(this->bidNodes.begin());
-	return;
-}
-
-/**
- * Calculate the hash value of a given key.
- * Note that key is specifically defined as
- * unsigned int to prevent undefined results
- * of a negative list index.
- *
- * @param key The key to hash
- * @return The calculated hash
- */
-unsigned int HashTable::hash(int key) {
-    // (4): Implement logic to calculate a hash value
-	// use modulo division to return the remainder of the key by hash table size
-	return key % this->tableSize;
-}
-
-/**
- * Insert a bid
- *
- * @param bid The bid to insert
- */
-void HashTable::Insert(Bid bid) {
-    // (5): Implement logic to insert a bid
-
-	// create the key- a hash of the bid's bidId
-	// requires conversion of bidId from string object to string to int
-	// key denotes bucket in the table to insert the bid
-	unsigned int key = this->hash(atoi(bid.bidId.c_str()));
-
-	// check whether the bucket presently holds data
-	// if it does, chain a linked list together
-	BidNode* keyNode = &(this->bidNodes.at(key));		// desired node bucket
-
-	if (keyNode == nullptr) {							// bucket is empty, insert node at desired bucket
-		BidNode* newNode = new BidNode(bid, key);
-		bidNodes.insert(bidNodes.begin() + key, *newNode);
-	} else {
-		if (keyNode->key == DEFAULT_KEY) {				// Bucket has an unused node, replace it
-			keyNode->key = key;							// with populated node for this bid
-			keyNode->bid = bid;
-			keyNode->next = nullptr;
-		} else {										// Chain the nodes in the desired bucket
-			while (keyNode->next != nullptr) {			// iterate to the end of the chain
-				keyNode = keyNode->next;
-			}
-			keyNode->next = new BidNode(bid, key);		// append a new node with bid to end of last node
-		}
-	}
-
-	return;
-}
-
-/**
- * Print all bids
- */
-void HashTable::PrintAll() {
-    // (6): Implement logic to print all bids
-	// Iterate over each index in the vector and loop through
-	// potential chains
-
-	for (unsigned int key = 0; key < this->bidNodes.size(); ++key) {
-		BidNode* iterationNode = &(this->bidNodes.at(key));
-		if (iterationNode == nullptr ||
-			iterationNode->key == DEFAULT_KEY) {				// bucket is empty or unused, do nothing
-			continue;
-		} else if (iterationNode->next == nullptr) {			// bucket has a single node
-			displayBid(iterationNode->bid);
-		} else {											// Chain of nodes in the desired bucket
-			while (iterationNode->next != nullptr) {			// iterate to the end of the chain
-				displayBid(iterationNode->bid);
-				iterationNode = iterationNode->next;
-			}
-			displayBid(iterationNode->bid);					// print the last node in the chain
-		}
-	}
-
-	return;
-}
-
-/**
- * Remove a bid
- *
- * @param bidId The bid id to search for
- */
-void HashTable::Remove(string bidId) {
-    // (7): Implement logic to remove a bid
-	unsigned int key = this->hash(atoi(bidId.c_str()));		// the key for the bidId passed in
-
-	BidNode* searchNode = &(this->bidNodes.at(key));
-
-	if (searchNode == nullptr ||
-	  	searchNode->key == DEFAULT_KEY) {					// no node found or is found but unused
-	   	cout << "Bid ID " << bidId << " not found.";
-	   	return;
-	}
-
-	if (searchNode != nullptr && 							// node found, is not empty
-	   	searchNode->key != DEFAULT_KEY &&					// and matches the bidId argument
-		searchNode->bid.bidId.compare(bidId) == 0) {
-
-		// remove the bid found
-		delete searchNode;
-
-	} else {													// node is found but buried in chain
-
-	   	while (searchNode != nullptr) {
-	   		if (searchNode->next->key != DEFAULT_KEY &&
-	   			searchNode->next->bid.bidId.compare(bidId) == 0) {	// next node matches, remove the bid
-	   				searchNode->next = searchNode->next->next;
-	   				delete searchNode->next;
-	   		}
-	   		searchNode = searchNode->next;
-	   	}
-	}
-
-	cout << "Bid ID " << bidId << " removed." << endl;
-
-	return;
-}
-
-/**
- * Search for the specified bidId
- *
- * @param bidId The bid id to search for
- */
-Bid HashTable::Search(string bidId) {
-    Bid bid;
-
-    // (8): Implement logic to search for and return a bid
-    unsigned int key = this->hash(atoi(bidId.c_str()));		// the key for the bidId passed in
-
-    BidNode* searchNode = &(this->bidNodes.at(key));
-
-    if (searchNode == nullptr ||
-    	searchNode->key == DEFAULT_KEY) {					// no node found or is found but unused
-    	return bid;											// return empty bid
-    }
-
-    if (searchNode != nullptr && 							// node found, is not empty
-    	searchNode->key != DEFAULT_KEY &&					// and matches the bidId argument
-		searchNode->bid.bidId.compare(bidId) == 0) {
-
-    	bid = searchNode->bid;								// return the bid found
-
-    } else {												// node is found but buried in chain
-    	while (searchNode != nullptr) {
-    		if (searchNode->key != DEFAULT_KEY &&
-    			searchNode->bid.bidId.compare(bidId) == 0) {	// node matches, return the bid
-    				return searchNode->bid;
-    		}
-    		searchNode = searchNode->next;
-    	}
-    }
-
-    return bid;
-}
-
 //============================================================================
 // Static methods used for testing
 //============================================================================
 
-/**
- * Display the bid information to the console (std::out)
- *
- * @param bid struct containing the bid info
- */
-void displayBid(Bid bid) {
-    cout << bid.bidId << ": " << bid.title << " | " << bid.amount << " | "
-            << bid.fund << endl;
-    return;
-}
-
 /**
  * Load a CSV file containing bids into a container
  *
  * @param csvPath the path to the CSV file to load
  * @return a container holding all the bids read
  */
-void loadBids(string csvPath, HashTable* hashTable) {
+void loadBids(string csvPath, FundIndexedHashTable* hashTable) {
     cout << "Loading CSV file " << csvPath << endl;
 
     // initialize the CSV Parser using the given path
@@ -305,38 +40,21 @@ void loadBids(string csvPath, HashTable* hashTable) {
 
     try {
         // loop to read rows of a CSV file
+        vector<Bid> bids;
+        bids.reserve(file.rowCount());
         for (unsigned int i = 0; i < file.rowCount(); i++) {
 
-            // Create a data structure and add to the collection of bids
-            Bid bid;
-            bid.bidId = file[i][1];
-            bid.title = file[i][0];
-            bid.fund = file[i][8];
-            bid.amount = strToDouble(file[i][4], '$');
-
-            //cout << "Item: " << bid.title << ", Fund: " << bid.fund << ", Amount: " << bid.amount << endl;
-
-            // push this bid to the end
-            hashTable->Insert(bid);
+            // Create a bid from the row
+            bids.push_back(bidFromRow(file[i]));
         }
+
+        // place them all at once, on every core
+        hashTable->BulkLoad(std::move(bids));
     } catch (csv::Error &e) {
         std::cerr << e.what() << std::endl;
     }
 }
 
-/**
- * Simple C function to convert a string to a double
- * after stripping out unwanted char
- *
- * credit: http://stackoverflow.com/a/24875936
- *
- * @param ch The character to strip out
- */
-double strToDouble(string str, char ch) {
-    str.erase(remove(str.begin(), str.end(), ch), str.end());
-    return atof(str.c_str());
-}
-
 /**
  * The one and only main() method
  */
@@ -364,9 +82,11 @@ int main(int argc, char* argv[]) {
     clock_t ticks;
 
     // Define a hash table to hold all the bids
-    HashTable* bidTable;
+    FundIndexedHashTable* bidTable = nullptr;
 
-    Bid bid;
+    const Bid* bid;
+    string fund;
+    vector<const Bid*> fundBids;
 
     int choice = 0;
     while (choice != 9) {
@@ -375,6 +95,9 @@ int main(int argc, char* argv[]) {
         cout << "  2. Display All Bids" << endl;
         cout << "  3. Find Bid" << endl;
         cout << "  4. Remove Bid" << endl;
+        cout << "  5. Find Bids by Fund" << endl;
+        cout << "  6. Table Statistics" << endl;
+        cout << "  7. Display All Bids Sorted by Id" << endl;
         cout << "  9. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
@@ -382,7 +105,7 @@ int main(int argc, char* argv[]) {
         switch (choice) {
 
         case 1:
-            bidTable = new HashTable();
+            bidTable = new FundIndexedHashTable();
 
             // Initialize a timer variable before loading bids
             ticks = clock();
@@ -403,12 +126,12 @@ int main(int argc, char* argv[]) {
         case 3:
             ticks = clock();
 
-            bid = bidTable->Search(searchValue);
+            bid = bidTable->Find(searchValue);
 
             ticks = clock() - ticks; // current clock ticks minus starting clock ticks
 
-            if (!bid.bidId.empty()) {
-                displayBid(bid);
+            if (bid != nullptr) {
+                displayBid(*bid);
             } else {
                 cout << "Bid Id " << searchValue << " not found." << endl;
             }
@@ -418,7 +141,39 @@ int main(int argc, char* argv[]) {
             break;
 
         case 4:
-            bidTable->Remove(searchValue);
+            if (bidTable->Remove(searchValue)) {
+                cout << "Bid ID " << searchValue << " removed." << endl;
+            } else {
+                cout << "Bid ID " << searchValue << " not found." << endl;
+            }
+            break;
+
+        case 5:
+            cout << "Enter fund: ";
+            cin >> ws;
+            getline(cin, fund);
+
+            ticks = clock();
+
+            fundBids = bidTable->SearchByFund(fund);
+
+            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+
+            for (const Bid* fundBid : fundBids) {
+                displayBid(*fundBid);
+            }
+            cout << fundBids.size() << " bids in fund " << fund << "." << endl;
+
+            cout << "time: " << ticks << " clock ticks" << endl;
+            cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            break;
+
+        case 6:
+            printTableStats(cout, bidTable->Stats());
+            break;
+
+        case 7:
+            bidTable->PrintAll(BidOrder::ById);
             break;
         }
     }
@@ -12,65 +12,16 @@
 #include <ctime>	// library needed for CLOCKS_PER_SEC
 // (https://en.cppreference.com/w/cpp/chrono/c/CLOCKS_PER_SEC)
 
-// Reference the CSVParser library
+// Reference the shared bid model and CSVParser library
+#include "Bid.hpp"
 #include "CSVparser.hpp"
 
 using namespace std;
 
-//============================================================================
-// Global definitions visible to all methods and classes
-//============================================================================
-
-// forward declarations
-double strToDouble(string str, char ch);
-
-struct Bid {
-    string title;
-    string fund;
-    double amount;
-    Bid() {
-        amount = 0.0;
-    }
-};
-
 //============================================================================
 // Static methods used for testing
 //============================================================================
 
-/**
- * Display the bid information
- *
- * @param bid struct containing the bid info
- */
-void displayBid(Bid bid) {
-    cout << bid.title << " | " << bid.amount << " | " << bid.fund << endl;
-    return;
-}
-
-/**
- * Prompt user for bid information
- *
- * @return Bid struct containing the bid info
- */
-Bid getBid() {
-    Bid bid;
-
-    cout << "Enter title: ";
-    cin.ignore();
-    getline(cin, bid.title);
-
-    cout << "Enter fund: ";
-    cin >> bid.fund;
-
-    cout << "Enter amount: ";
-    cin.ignore();
-    string strAmount;
-    getline(cin, strAmount);
-    bid.amount = strToDouble(strAmount, '$');
-
-    return bid;
-}
-
 /**
  * Load a CSV file containing bids into a container
  *
@@ -88,12 +39,7 @@ vector<Bid> loadBids(string csvPath) {
 	// loop to read rows of a CSV file
 	for (unsigned int i = 0; i < file.rowCount(); i++) {
         // create a data structure to hold data from each row and add to vector
-		Bid bidRecord;
-		bidRecord.title = file[i][0];
-		bidRecord.fund = file[i][8];
-		bidRecord.amount = strToDouble(file[i][4], '$');
-
-		bids.push_back(bidRecord);
+		bids.push_back(bidFromRow(file[i]));
     }
 
 	// Output number of records read
@@ -102,19 +48,6 @@ vector<Bid> loadBids(string csvPath) {
     return bids;
 }
 
-/**
- * Simple C function to convert a string to a double
- * after stripping out unwanted char
- *
- * credit: http://stackoverflow.com/a/24875936
- *
- * @param ch The character to strip out
- */
-double strToDouble(string str, char ch) {
-    str.erase(remove(str.begin(), str.end(), ch), str.end());
-    return atof(str.c_str());
-}
-
 int main(int argc, char* argv[]) {
 
     // process command line arguments
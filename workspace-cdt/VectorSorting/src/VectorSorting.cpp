@@ -10,70 +10,15 @@
 #include <iostream>
 #include <time.h>
 
+#include "Bid.hpp"
 #include "CSVparser.hpp"
 
 using namespace std;
 
-//============================================================================
-// Global definitions visible to all methods and classes
-//============================================================================
-
-// forward declarations
-double strToDouble(string str, char ch);
-
-// define a structure to hold bid information
-struct Bid {
-    string bidId; // unique identifier
-    string title;
-    string fund;
-    double amount;
-    Bid() {
-        amount = 0.0;
-    }
-};
-
 //============================================================================
 // Static methods used for testing
 //============================================================================
 
-/**
- * Display the bid information to the console (std::out)
- *
- * @param bid struct containing the bid info
- */
-void displayBid(Bid bid) {
-    cout << bid.bidId << ": " << bid.title << " | " << bid.amount << " | "
-            << bid.fund << endl;
-    return;
-}
-
-/**
- * Prompt user for bid information using console (std::in)
- *
- * @return Bid struct containing the bid info
- */
-Bid getBid() {
-    Bid bid;
-
-    cout << "Enter Id: ";
-    cin.ignore();
-    getline(cin, bid.bidId);
-
-    cout << "Enter title: ";
-    getline(cin, bid.title);
-
-    cout << "Enter fund: ";
-    cin >> bid.fund;
-
-    cout << "Enter amount: ";
-    cin.ignore();
-    string strAmount;
-    getline(cin, strAmount);
-    bid.amount = strToDouble(strAmount, '$');
-
-    return bid;
-}
-
 /**
  * Load a CSV file containing bids into a container
  *
@@ -93,17 +38,8 @@ vector<Bid> loadBids(string csvPath) {
         // loop to read rows of a CSV file
         for (unsigned int i = 0; i < file.rowCount(); i++) {
 
-            // Create a data structure and add to the collection of bids
-            Bid bid;
-            bid.bidId = file[i][1];
-            bid.title = file[i][0];
-            bid.fund = file[i][8];
-            bid.amount = strToDouble(file[i][4], '$');
-
-            //cout << "Item: " << bid.title << ", Fund: " << bid.fund << ", Amount: " << bid.amount << endl;
-
-            // push this bid to the end
-            bids.push_back(bid);
+            // Create a bid from the row and move it to the end
+            bids.push_back(bidFromRow(file[i]));
         }
     } catch (csv::Error &e) {
         std::cerr << e.what() << std::endl;
@@ -126,11 +62,10 @@ int partition(vector<Bid>& bids, int begin, int end) {
 	int low = begin;
 	int high = end;
 
-	// placeholder for swapping bids
-	Bid* temp = new Bid();
+	int midPoint = begin + (end - begin) / 2;
 
-	int midPoint = (begin + (end - begin)) / 2;
-	Bid pivotValue = bids.at(midPoint);
+	// only the pivot title is needed; bids themselves are swapped by move
+	string pivotTitle = bids.at(midPoint).title;
 
 	// flag for looping
 	bool done = false;
@@ -139,12 +74,12 @@ int partition(vector<Bid>& bids, int begin, int end) {
 		// compare the low point to the midpoint
 
 		// keep incrementing low while title is less than the pivot value title
-		while (bids.at(low).title.compare(pivotValue.title) < 0) {
+		while (bids.at(low).title.compare(pivotTitle) < 0) {
 			++low;
 		}
 
 		// keep decrementing high while title is greater than the pivot value title
-		while (pivotValue.title.compare(bids.at(high).title) < 0) {
+		while (pivotTitle.compare(bids.at(high).title) < 0) {
 			--high;
 		}
 
@@ -158,13 +93,11 @@ int partition(vector<Bid>& bids, int begin, int end) {
 		} else {
 			// swap the element at the low index and the high index to
 			// place the bid value in the the proper partition
-			*temp = bids.at(low);
-			bids.at(low) = bids.at(high);
-			bids.at(high) = *temp;
-		}
+			swap(bids.at(low), bids.at(high));
 
-		++low;
-		--high;
+			++low;
+			--high;
+		}
 	}
 
 	// return the highest index of the low partition
@@ -214,7 +147,6 @@ void selectionSort(vector<Bid>& bids) {
 
 	// track the index of the minimum value for each iteration
 	unsigned int minValIndex;
-	Bid* temp = new Bid();					// temp Bid holder for sorting
 
 	// outer loop to iterate over each vector element
 	for (unsigned int i = 0; i < bids.size(); ++i) {
@@ -235,28 +167,13 @@ void selectionSort(vector<Bid>& bids) {
 		// if there's been a change
 		// everything less than current i iteration is sorted
 		if (minValIndex != i) {
-			*temp = bids.at(i);
-			bids.at(i) = bids.at(minValIndex);
-			bids.at(minValIndex) = *temp;
+			swap(bids.at(i), bids.at(minValIndex));
 		}
 	}
 
 	return;
 }
 
-/**
- * Simple C function to convert a string to a double
- * after stripping out unwanted char
- *
- * credit: http://stackoverflow.com/a/24875936
- *
- * @param ch The character to strip out
- */
-double strToDouble(string str, char ch) {
-    str.erase(remove(str.begin(), str.end(), ch), str.end());
-    return atof(str.c_str());
-}
-
 /**
  * The one and only main() method
  */